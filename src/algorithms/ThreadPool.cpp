@@ -0,0 +1,131 @@
+//
+// Implementation of ThreadPool
+//
+
+#include "../include/algorithms/ThreadPool.h"
+#include <algorithm>
+
+namespace algorithms {
+
+    ThreadPool::ThreadPool(unsigned threads)
+        : ranges_(threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency())) {
+        // Worker 0 is whichever thread calls parallel_for
+        threads_.reserve(ranges_.size() - 1);
+        for (unsigned worker = 1; worker < ranges_.size(); ++worker) {
+            threads_.emplace_back([this, worker]() { worker_loop(worker); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::run(std::size_t count, const std::function<void(std::size_t, unsigned)>& job) {
+        if (count == 0) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const std::size_t workers = ranges_.size();
+            for (std::size_t w = 0; w < workers; ++w) {
+                std::lock_guard<std::mutex> range_lock(ranges_[w].mutex);
+                ranges_[w].begin = count * w / workers;
+                ranges_[w].end = count * (w + 1) / workers;
+            }
+            job_ = job;
+            error_ = nullptr;
+            busy_ = static_cast<unsigned>(threads_.size());
+            ++job_id_;
+        }
+        wake_.notify_all();
+
+        drain(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this]() { return busy_ == 0; });
+        job_ = nullptr;
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+    void ThreadPool::worker_loop(unsigned worker) {
+        std::uint64_t seen_job = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&]() { return stop_ || job_id_ != seen_job; });
+                if (stop_) {
+                    return;
+                }
+                seen_job = job_id_;
+            }
+
+            drain(worker);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--busy_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+
+    void ThreadPool::drain(unsigned worker) {
+        std::size_t index;
+        while (take(worker, index)) {
+            try {
+                job_(index, worker);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+        }
+    }
+
+    bool ThreadPool::take(unsigned worker, std::size_t& index) {
+        {
+            Range& own = ranges_[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (own.begin < own.end) {
+                index = own.begin++;
+                return true;
+            }
+        }
+
+        // Steal the back half of the first non-empty range after our own
+        const auto workers = static_cast<unsigned>(ranges_.size());
+        for (unsigned offset = 1; offset < workers; ++offset) {
+            Range& victim = ranges_[(worker + offset) % workers];
+            std::size_t begin;
+            std::size_t end;
+            {
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (victim.begin >= victim.end) {
+                    continue;
+                }
+                begin = victim.begin + (victim.end - victim.begin) / 2;
+                end = victim.end;
+                victim.end = begin;
+            }
+
+            index = begin;
+            Range& own = ranges_[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            own.begin = begin + 1;
+            own.end = end;
+            return true;
+        }
+        return false;
+    }
+
+} // namespace algorithms
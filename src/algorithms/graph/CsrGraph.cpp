@@ -0,0 +1,73 @@
+//
+// Conversion between adjacency-list and CSR graph layouts
+//
+
+#include "../../include/algorithms/CsrGraph.h"
+#include <limits>
+#include <stdexcept>
+
+namespace algorithms::graph {
+
+    CsrGraph CsrGraph::from_adjacency(const Graph& graph) {
+        std::size_t total_edges = 0;
+        for (const auto& edges : graph.adj) {
+            total_edges += edges.size();
+        }
+        if (total_edges > std::numeric_limits<std::uint32_t>::max() ||
+            graph.adj.size() > std::numeric_limits<NodeId>::max()) {
+            throw std::length_error("Graph is too large for 32-bit CSR indices");
+        }
+
+        CsrGraph csr;
+        csr.offsets.reserve(graph.adj.size() + 1);
+        csr.targets.reserve(total_edges);
+        csr.weights.reserve(total_edges);
+
+        for (const auto& edges : graph.adj) {
+            for (const auto& edge : edges) {
+                csr.targets.push_back(static_cast<NodeId>(edge.to));
+                csr.weights.push_back(edge.weight);
+            }
+            csr.offsets.push_back(static_cast<std::uint32_t>(csr.targets.size()));
+        }
+        return csr;
+    }
+
+    Graph CsrGraph::to_adjacency() const {
+        Graph graph;
+        graph.adj.resize(node_count());
+        for (std::size_t u = 0; u < node_count(); ++u) {
+            auto& edges = graph.adj[u];
+            edges.reserve(offsets[u + 1] - offsets[u]);
+            for (std::uint32_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+                edges.push_back({targets[e], weights[e]});
+            }
+        }
+        return graph;
+    }
+
+    CsrGraph CsrGraph::transposed() const {
+        const std::size_t count = node_count();
+        CsrGraph reversed;
+        reversed.offsets.assign(count + 1, 0);
+        for (NodeId v : targets) {
+            ++reversed.offsets[v + 1];
+        }
+        for (std::size_t u = 0; u < count; ++u) {
+            reversed.offsets[u + 1] += reversed.offsets[u];
+        }
+
+        reversed.targets.resize(edge_count());
+        reversed.weights.resize(edge_count());
+        std::vector<std::uint32_t> next(reversed.offsets.begin(), reversed.offsets.end() - 1);
+        for (std::size_t u = 0; u < count; ++u) {
+            for (std::uint32_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+                std::uint32_t slot = next[targets[e]]++;
+                reversed.targets[slot] = static_cast<NodeId>(u);
+                reversed.weights[slot] = weights[e];
+            }
+        }
+        return reversed;
+    }
+
+} // namespace algorithms::graph
@@ -0,0 +1,269 @@
+//
+// Implementation of GraphCache
+//
+
+#include "../../include/algorithms/GraphCache.h"
+#include "../../include/serialization/MappedFile.h"
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+namespace algorithms {
+
+    namespace {
+
+        constexpr char MAGIC[8] = {'P', 'F', 'G', 'R', 'A', 'P', 'H', '\0'};
+
+        // Followed by offsets (node_count + 1 x u32), targets (edge_count x u32),
+        // weights (edge_count x f64) and points (node_count x 2 f64), each
+        // starting at a multiple of 8 bytes
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t header_size;
+            std::uint64_t key;
+            std::uint64_t node_count;
+            std::uint64_t edge_count;
+        };
+        static_assert(sizeof(Header) == 40, "Header must have no padding");
+
+        constexpr bool LITTLE_ENDIAN_HOST = std::endian::native == std::endian::little;
+
+        constexpr std::uint64_t align8(std::uint64_t bytes) {
+            return (bytes + 7) & ~std::uint64_t{7};
+        }
+
+        struct Layout {
+            std::uint64_t offsets;
+            std::uint64_t targets;
+            std::uint64_t weights;
+            std::uint64_t points;
+            std::uint64_t end;
+        };
+
+        // Counts are below 2^32 (NodeId and CSR offsets are 32-bit), so nothing overflows
+        Layout layout(std::uint64_t node_count, std::uint64_t edge_count) {
+            Layout l {};
+            l.offsets = sizeof(Header);
+            l.targets = align8(l.offsets + (node_count + 1) * sizeof(std::uint32_t));
+            l.weights = align8(l.targets + edge_count * sizeof(graph::NodeId));
+            l.points = l.weights + edge_count * sizeof(double);
+            l.end = l.points + node_count * 2 * sizeof(double);
+            return l;
+        }
+
+        /**
+         * Word-at-a-time FNV-1a style mixing with a final avalanche
+         */
+        class Hasher {
+        public:
+            void add(std::uint64_t word) {
+                hash_ = (hash_ ^ word) * 0x100000001b3ULL;
+            }
+
+            void add(double value) {
+                // -0.0 and 0.0 describe the same scene
+                add(std::bit_cast<std::uint64_t>(value == 0.0 ? 0.0 : value));
+            }
+
+            void add(std::string_view text) {
+                add(static_cast<std::uint64_t>(text.size()));
+                for (char c : text) {
+                    add(static_cast<std::uint64_t>(static_cast<unsigned char>(c)));
+                }
+            }
+
+            [[nodiscard]] std::uint64_t finish() const {
+                std::uint64_t h = hash_;
+                h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+                return h ^ (h >> 31);
+            }
+
+        private:
+            std::uint64_t hash_ = 0xcbf29ce484222325ULL;
+        };
+
+        template <typename T>
+        void write_array(std::ofstream& out, const T* data, std::size_t count) {
+            out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+        }
+
+        void pad_to(std::ofstream& out, std::uint64_t offset) {
+            static constexpr char zeros[8] {};
+            auto position = static_cast<std::uint64_t>(out.tellp());
+            if (position < offset) {
+                out.write(zeros, static_cast<std::streamsize>(offset - position));
+            }
+        }
+
+    }
+
+    GraphCache::GraphCache(std::filesystem::path directory)
+        : directory_(std::move(directory)) {}
+
+    std::uint64_t GraphCache::key(const geometry::Scene& scene, std::string_view builder,
+                                  std::span<const double> parameters) {
+        Hasher hasher;
+        hasher.add(builder);
+        hasher.add(static_cast<std::uint64_t>(parameters.size()));
+        for (double parameter : parameters) {
+            hasher.add(parameter);
+        }
+        hasher.add(scene.width);
+        hasher.add(scene.height);
+        hasher.add(static_cast<std::uint64_t>(scene.obstacles.size()));
+        for (const auto& disk : scene.obstacles) {
+            hasher.add(disk.center.x);
+            hasher.add(disk.center.y);
+            hasher.add(disk.radius);
+            hasher.add(static_cast<std::uint64_t>(disk.id));
+        }
+        return hasher.finish();
+    }
+
+    std::uint64_t GraphCache::key(const geometry::Scene& scene, const graph::GridGraphBuilder& builder) {
+        const double parameters[] = {builder.get_grid_step(), builder.is_diagonal_allowed() ? 1.0 : 0.0};
+        return key(scene, builder.name(), parameters);
+    }
+
+    std::filesystem::path GraphCache::file_path(std::uint64_t key) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.graph", static_cast<unsigned long long>(key));
+        return directory_ / name;
+    }
+
+    std::optional<SearchGraph> GraphCache::load(std::uint64_t key) const {
+        if constexpr (!LITTLE_ENDIAN_HOST) {
+            return std::nullopt;
+        }
+        const std::filesystem::path path = file_path(key);
+        std::error_code error;
+        if (!std::filesystem::is_regular_file(path, error)) {
+            return std::nullopt;
+        }
+
+        std::optional<serialization::MappedFile> file;
+        try {
+            file.emplace(path.string());
+        } catch (const std::runtime_error&) {
+            return std::nullopt;
+        }
+        if (file->size() < sizeof(Header)) {
+            return std::nullopt;
+        }
+        Header header {};
+        std::memcpy(&header, file->data(), sizeof(Header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+            header.header_size != sizeof(Header) || header.key != key ||
+            header.node_count >= graph::INVALID_NODE || header.edge_count >= graph::INVALID_NODE) {
+            return std::nullopt;
+        }
+        const Layout l = layout(header.node_count, header.edge_count);
+        if (l.end != file->size()) {
+            return std::nullopt;
+        }
+
+        const auto node_count = static_cast<std::size_t>(header.node_count);
+        const auto edge_count = static_cast<std::size_t>(header.edge_count);
+        const auto* offsets = reinterpret_cast<const std::uint32_t*>(file->data() + l.offsets);
+        const auto* targets = reinterpret_cast<const graph::NodeId*>(file->data() + l.targets);
+        const auto* weights = reinterpret_cast<const double*>(file->data() + l.weights);
+        const auto* points = reinterpret_cast<const double*>(file->data() + l.points);
+
+        // A corrupt entry must not hand out-of-range ids to a search
+        if (offsets[0] != 0 || offsets[node_count] != edge_count) {
+            return std::nullopt;
+        }
+        for (std::size_t u = 0; u < node_count; ++u) {
+            if (offsets[u] > offsets[u + 1]) {
+                return std::nullopt;
+            }
+        }
+        for (std::size_t e = 0; e < edge_count; ++e) {
+            if (targets[e] >= node_count) {
+                return std::nullopt;
+            }
+        }
+
+        SearchGraph graph;
+        graph.graph.offsets.assign(offsets, offsets + node_count + 1);
+        graph.graph.targets.assign(targets, targets + edge_count);
+        graph.graph.weights.assign(weights, weights + edge_count);
+        graph.points.resize(node_count);
+        for (std::size_t i = 0; i < node_count; ++i) {
+            graph.points[i] = {points[2 * i], points[2 * i + 1]};
+        }
+        return graph;
+    }
+
+    bool GraphCache::store(std::uint64_t key, const SearchGraph& graph) const {
+        if constexpr (!LITTLE_ENDIAN_HOST) {
+            return false;
+        }
+        const std::size_t node_count = graph.graph.node_count();
+        const std::size_t edge_count = graph.graph.edge_count();
+        if (graph.points.size() != node_count) {
+            throw std::invalid_argument("Search graph needs one point per node");
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+        if (error) {
+            return false;
+        }
+
+        // Unique per writer, so concurrent stores of the same key do not interleave
+        const std::filesystem::path path = file_path(key);
+        std::filesystem::path temporary = path;
+        temporary += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+                                             static_cast<std::size_t>(
+                                                 std::chrono::steady_clock::now().time_since_epoch().count()));
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                return false;
+            }
+
+            Header header {};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = VERSION;
+            header.header_size = sizeof(Header);
+            header.key = key;
+            header.node_count = node_count;
+            header.edge_count = edge_count;
+            const Layout l = layout(node_count, edge_count);
+
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            write_array(out, graph.graph.offsets.data(), node_count + 1);
+            pad_to(out, l.targets);
+            write_array(out, graph.graph.targets.data(), edge_count);
+            pad_to(out, l.weights);
+            write_array(out, graph.graph.weights.data(), edge_count);
+            for (const auto& point : graph.points) {
+                const double xy[2] = {point.x, point.y};
+                write_array(out, xy, 2);
+            }
+            out.flush();
+            if (!out) {
+                out.close();
+                std::filesystem::remove(temporary, error);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+        return true;
+    }
+
+} // namespace algorithms
@@ -3,13 +3,80 @@
 //
 
 #include "../../include/algorithms/GridGraphBuilder.h"
+#include "../../include/algorithms/Instrumentation.h"
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
 #include <limits>
+#include <numeric>
+#include <thread>
 
 namespace algorithms::graph {
 
+    namespace {
+
+        /**
+         * Runs fn(tile) for tiles 0..tile_count-1, one thread per tile;
+         * the calling thread takes tile 0. Counters reported by the workers
+         * end up in the caller's active profile.
+         */
+        template <typename Fn>
+        void run_tiles(std::size_t tile_count, Fn&& fn) {
+            if (tile_count == 0) {
+                return;
+            }
+            instrumentation::ProfileFork fork(tile_count);
+            std::vector<std::thread> workers;
+            workers.reserve(tile_count - 1);
+            for (std::size_t tile = 1; tile < tile_count; ++tile) {
+                workers.emplace_back([&fn, &fork, tile]() {
+                    instrumentation::ProfileScope scope(fork.branch(tile));
+                    fn(tile);
+                });
+            }
+            fn(0);
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            fork.merge();
+        }
+
+        // Every layer is a lattice of cell centers; an edge layer blocks the
+        // segment from each center one cell along its direction, the cell
+        // layer (zero direction) the center itself
+        struct LayerDirection {
+            GridOccupancy::Layer layer;
+            int vx;
+            int vy;
+        };
+        constexpr LayerDirection LAYERS[] = {
+            {GridOccupancy::Cell, 0, 0},
+            {GridOccupancy::EdgeX, 1, 0},
+            {GridOccupancy::EdgeY, 0, 1},
+            {GridOccupancy::EdgeDiagonal, 1, 1},
+            {GridOccupancy::EdgeAntiDiagonal, -1, 1},
+        };
+
+        // Narrows [first, last] to the x with lo <= a * x + b <= hi
+        void clip_linear(double a, double b, double lo, double hi, double& first, double& last) {
+            if (a == 0.0) {
+                if (b < lo || b > hi) {
+                    first = std::numeric_limits<double>::infinity();
+                    last = -std::numeric_limits<double>::infinity();
+                }
+                return;
+            }
+            double x0 = (lo - b) / a;
+            double x1 = (hi - b) / a;
+            if (a < 0.0) {
+                std::swap(x0, x1);
+            }
+            first = std::max(first, x0);
+            last = std::min(last, x1);
+        }
+
+    }
+
     GridGraphBuilder::GridGraphBuilder(double grid_step, bool allow_diagonal)
         : grid_step_(grid_step), allow_diagonal_(allow_diagonal) {
         if (grid_step <= 0) {
@@ -18,157 +85,621 @@ namespace algorithms::graph {
     }
 
     Graph GridGraphBuilder::build(const geometry::Scene& scene) {
-        // Clear previous mappings
-        node_to_point_.clear();
-        point_to_node_.clear();
+        // Rasterize obstacles into the occupancy bitmap
+        occupancy_ = build_occupancy(scene);
+        const GridOccupancy& occupancy = occupancy_;
+        const std::vector<int> tiles = row_tiles(occupancy);
 
-        // Calculate grid dimensions
-        int grid_width = static_cast<int>(std::ceil(scene.width / grid_step_));
-        int grid_height = static_cast<int>(std::ceil(scene.height / grid_step_));
+        // First pass: create nodes for free grid cells
+        create_nodes(occupancy, tiles);
 
-        // First pass: create nodes for valid grid cells
-        // A cell is valid if its center is not inside any obstacle and is within bounds
-        for (int gy = 0; gy < grid_height; ++gy) {
-            for (int gx = 0; gx < grid_width; ++gx) {
-                geometry::Point cell_center = grid_to_point(gx, gy);
-                
-                // Check if cell center is valid (in bounds and not in obstacle)
-                if (is_point_in_bounds(cell_center, scene) && 
-                    !is_point_in_obstacle(cell_center, scene)) {
-                    
-                    std::size_t node_id = node_to_point_.size();
-                    node_to_point_.push_back(cell_center);
-                    
-                    // Create hash key from grid coordinates for fast lookup
-                    std::size_t grid_key = static_cast<std::size_t>(gy) * grid_width + static_cast<std::size_t>(gx);
-                    point_to_node_[grid_key] = node_id;
-                }
-            }
-        }
+        PF_SCOPED_TIMER("grid.edges");
 
         // Initialize graph with empty adjacency lists
         Graph graph;
         graph.adj.resize(node_to_point_.size());
 
-        // Second pass: create edges between adjacent valid nodes
-        for (int gy = 0; gy < grid_height; ++gy) {
-            for (int gx = 0; gx < grid_width; ++gx) {
-                std::size_t grid_key = static_cast<std::size_t>(gy) * grid_width + static_cast<std::size_t>(gx);
-                
-                // Check if this grid cell has a node
-                auto it = point_to_node_.find(grid_key);
-                if (it == point_to_node_.end()) {
-                    continue; // This cell doesn't have a node (obstacle or out of bounds)
+        // Second pass: create edges between adjacent valid nodes; every tile
+        // only writes the adjacency lists of its own nodes
+        run_tiles(tiles.size() - 1, [&](std::size_t tile) {
+            Graph::Edge edges[8];
+            for (int gy = tiles[tile]; gy < tiles[tile + 1]; ++gy) {
+                for (int gx = 0; gx < occupancy.width(); ++gx) {
+                    // Check if this grid cell has a node
+                    if (!occupancy.is_cell_free(gx, gy)) {
+                        continue; // Obstacle or out of bounds
+                    }
+
+                    int count = collect_edges(occupancy, gx, gy, edges);
+                    graph.adj[cell_to_node_[occupancy.index(gx, gy)]].assign(edges, edges + count);
                 }
+            }
+        });
+
+        PF_COUNT(bytes_allocated, graph.memory_bytes());
+        return graph;
+    }
+
+    CsrGraph GridGraphBuilder::build_csr(const geometry::Scene& scene) {
+        occupancy_ = build_occupancy(scene);
+        const GridOccupancy& occupancy = occupancy_;
+        const std::vector<int> tiles = row_tiles(occupancy);
+        const std::size_t tile_count = tiles.size() - 1;
+        const int num_directions = allow_diagonal_ ? 8 : 4;
+
+        create_nodes(occupancy, tiles);
 
-                std::size_t from_node = it->second;
-                geometry::Point from_point = node_to_point_[from_node];
-
-                // Check neighbors: 4-connectivity (up, down, left, right)
-                int dx[] = {0, 1, 0, -1};
-                int dy[] = {-1, 0, 1, 0};
-                int num_directions = 4;
-
-                // Add diagonal directions if allowed (8-connectivity)
-                if (allow_diagonal_) {
-                    int diag_dx[] = {-1, 1, 1, -1};
-                    int diag_dy[] = {-1, -1, 1, 1};
-                    for (int i = 0; i < 4; ++i) {
-                        dx[num_directions] = diag_dx[i];
-                        dy[num_directions] = diag_dy[i];
-                        ++num_directions;
+        PF_SCOPED_TIMER("grid.edges");
+
+        // Edge count per tile; the prefix sum gives each tile its slice of the edge arrays
+        std::vector<std::size_t> first_edge(tile_count + 1, 0);
+        run_tiles(tile_count, [&](std::size_t tile) {
+            std::size_t count = 0;
+            for (int gy = tiles[tile]; gy < tiles[tile + 1]; ++gy) {
+                for (int gx = 0; gx < occupancy.width(); ++gx) {
+                    if (!occupancy.is_cell_free(gx, gy)) {
+                        continue;
+                    }
+                    for (int dir = 0; dir < num_directions; ++dir) {
+                        count += occupancy.is_edge_free(gx, gy, dir);
                     }
                 }
+            }
+            first_edge[tile + 1] = count;
+        });
+        std::partial_sum(first_edge.begin(), first_edge.end(), first_edge.begin());
+        if (first_edge.back() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("Grid has too many edges for 32-bit CSR offsets");
+        }
 
-                // Check each neighbor direction
-                for (int dir = 0; dir < num_directions; ++dir) {
-                    int nx = gx + dx[dir];
-                    int ny = gy + dy[dir];
+        CsrGraph graph;
+        graph.offsets.assign(node_to_point_.size() + 1, 0);
+        graph.targets.resize(first_edge.back());
+        graph.weights.resize(first_edge.back());
 
-                    // Check bounds
-                    if (nx < 0 || nx >= grid_width || ny < 0 || ny >= grid_height) {
+        // Nodes are numbered in row-major order, so walking a tile's rows in the
+        // same order writes each node's edges right after the previous node's.
+        run_tiles(tile_count, [&](std::size_t tile) {
+            Graph::Edge edges[8];
+            std::size_t position = first_edge[tile];
+            for (int gy = tiles[tile]; gy < tiles[tile + 1]; ++gy) {
+                for (int gx = 0; gx < occupancy.width(); ++gx) {
+                    if (!occupancy.is_cell_free(gx, gy)) {
                         continue;
                     }
 
-                    std::size_t neighbor_key = static_cast<std::size_t>(ny) * grid_width + static_cast<std::size_t>(nx);
-                    auto neighbor_it = point_to_node_.find(neighbor_key);
-                    
-                    if (neighbor_it != point_to_node_.end()) {
-                        std::size_t to_node = neighbor_it->second;
-                        geometry::Point to_point = node_to_point_[to_node];
-
-                        // Check if edge is valid (line segment doesn't intersect obstacles)
-                        // For simplicity, we check if both endpoints are valid
-                        // More sophisticated: check if the edge segment intersects any obstacle
-                        bool edge_valid = true;
-                        
-                        // Simple check: verify midpoint is not in obstacle
-                        geometry::Point midpoint((from_point.x + to_point.x) / 2.0,
-                                                (from_point.y + to_point.y) / 2.0);
-                        if (is_point_in_obstacle(midpoint, scene)) {
-                            edge_valid = false;
-                        }
+                    int count = collect_edges(occupancy, gx, gy, edges);
+                    for (int i = 0; i < count; ++i, ++position) {
+                        graph.targets[position] = static_cast<NodeId>(edges[i].to);
+                        graph.weights[position] = edges[i].weight;
+                    }
+                    graph.offsets[cell_to_node_[occupancy.index(gx, gy)] + 1] = static_cast<std::uint32_t>(position);
+                }
+            }
+        });
+
+        PF_COUNT(bytes_allocated, graph.memory_bytes());
+        return graph;
+    }
+
+    void GridGraphBuilder::restore(const geometry::Scene& scene, const CsrGraph& graph,
+                                   std::span<const geometry::Point> node_points) {
+        if (graph.node_count() != node_points.size()) {
+            throw std::invalid_argument("Graph needs one point per node");
+        }
+        auto [grid_width, grid_height] = grid_size(scene);
+        GridOccupancy occupancy(grid_width, grid_height);
+        if (occupancy.cell_count() >= INVALID_NODE) {
+            throw std::length_error("Grid has too many cells for 32-bit node ids");
+        }
 
-                        if (edge_valid) {
-                            // Calculate edge weight (distance)
-                            double weight = calculate_distance(from_point, to_point);
-                            
-                            // Add edge (undirected graph, so add to both nodes)
-                            graph.adj[from_node].push_back({to_node, weight});
+        // Everything is checked into locals first, so a rejected graph leaves
+        // the builder as it was
+        std::vector<std::pair<int, int>> node_cells(node_points.size());
+        std::vector<NodeId> cell_to_node(occupancy.cell_count(), INVALID_NODE);
+        for (std::size_t node = 0; node < node_points.size(); ++node) {
+            auto [gx, gy] = point_to_grid(node_points[node]);
+            if (!occupancy.in_grid(gx, gy)) {
+                throw std::invalid_argument("Node point outside the grid of the scene");
+            }
+            NodeId& owner = cell_to_node[occupancy.index(gx, gy)];
+            if (owner != INVALID_NODE) {
+                throw std::invalid_argument("Two nodes in the same grid cell");
+            }
+            node_cells[node] = {gx, gy};
+            owner = static_cast<NodeId>(node);
+        }
+
+        // Everything blocked, then the cells with a node and the edges of the
+        // graph freed: edges between free cells that the graph lacks stay blocked
+        if (occupancy.cell_count() > 0) {
+            for (int layer = 0; layer < GridOccupancy::LayerCount; ++layer) {
+                occupancy.set_blocked_range(static_cast<GridOccupancy::Layer>(layer), 0, occupancy.cell_count() - 1);
+            }
+        }
+        int direction_of[3][3];
+        for (int dir = 0; dir < 8; ++dir) {
+            direction_of[GridOccupancy::dy[dir] + 1][GridOccupancy::dx[dir] + 1] = dir;
+        }
+        for (NodeId u = 0; u < graph.node_count(); ++u) {
+            auto [gx, gy] = node_cells[u];
+            occupancy.set_blocked(GridOccupancy::Cell, occupancy.index(gx, gy), false);
+            for (NodeId v : graph.neighbors(u)) {
+                int ddx = node_cells[v].first - gx;
+                int ddy = node_cells[v].second - gy;
+                if (std::abs(ddx) > 1 || std::abs(ddy) > 1 || (ddx == 0 && ddy == 0)) {
+                    throw std::invalid_argument("Graph edge between cells that are not neighbours");
+                }
+                auto [layer, cell] = occupancy.edge_slot(gx, gy, direction_of[ddy + 1][ddx + 1]);
+                occupancy.set_blocked(layer, cell, false);
+            }
+        }
+
+        occupancy_ = std::move(occupancy);
+        cell_to_node_ = std::move(cell_to_node);
+        grid_width_ = grid_width;
+        grid_height_ = grid_height;
+        node_to_point_.assign(node_points.begin(), node_points.end());
+    }
+
+    std::vector<std::size_t> GridGraphBuilder::update(const geometry::Scene& scene,
+                                                      std::span<const geometry::ObstacleDelta> deltas,
+                                                      Graph& graph) {
+        if (occupancy_.cell_count() == 0 || grid_size(scene) != std::pair{grid_width_, grid_height_} ||
+            graph.adj.size() != node_to_point_.size()) {
+            return GraphBuilder::update(scene, deltas, graph);
+        }
+
+        std::vector<std::size_t> affected;
+        std::vector<std::uint16_t> before;
+        std::vector<std::size_t> changed_cells;
+        Graph::Edge edges[8];
+
+        for (const auto& delta : deltas) {
+            const CellWindow window = delta_window(delta, occupancy_);
+            const int x0 = window.x0;
+            const int y0 = window.y0;
+            const int x1 = window.x1;
+            const int y1 = window.y1;
+
+            // Edges leaving the window start one cell further out
+            int sx0 = std::max(x0 - 1, 0);
+            int sy0 = std::max(y0 - 1, 0);
+            int sx1 = std::min(x1 + 1, grid_width_ - 1);
+            int sy1 = std::min(y1 + 1, grid_height_ - 1);
+
+            before.clear();
+            for (int gy = sy0; gy <= sy1; ++gy) {
+                for (int gx = sx0; gx <= sx1; ++gx) {
+                    before.push_back(connectivity(gx, gy));
+                }
+            }
+
+            refresh_occupancy(scene, window, occupancy_);
+
+            // Nodes for newly freed cells first, so that edges can point at them
+            changed_cells.clear();
+            std::size_t i = 0;
+            for (int gy = sy0; gy <= sy1; ++gy) {
+                for (int gx = sx0; gx <= sx1; ++gx, ++i) {
+                    if (connectivity(gx, gy) == before[i]) {
+                        continue;
+                    }
+                    std::size_t cell = occupancy_.index(gx, gy);
+                    if (occupancy_.is_cell_free(gx, gy) && cell_to_node_[cell] == INVALID_NODE) {
+                        if (node_to_point_.size() >= INVALID_NODE) {
+                            throw std::length_error("Grid has too many cells for 32-bit node ids");
                         }
+                        cell_to_node_[cell] = static_cast<NodeId>(node_to_point_.size());
+                        node_to_point_.push_back(grid_to_point(gx, gy));
                     }
+                    changed_cells.push_back(cell);
+                }
+            }
+
+            graph.adj.resize(node_to_point_.size());
+            for (std::size_t cell : changed_cells) {
+                NodeId node = cell_to_node_[cell];
+                if (node == INVALID_NODE) {
+                    continue;
                 }
+                int gx = static_cast<int>(cell % grid_width_);
+                int gy = static_cast<int>(cell / grid_width_);
+                int count = occupancy_.is_cell_free(gx, gy) ? collect_edges(occupancy_, gx, gy, edges) : 0;
+                graph.adj[node].assign(edges, edges + count);
+                affected.push_back(node);
             }
         }
 
-        return graph;
+        std::sort(affected.begin(), affected.end());
+        affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+        return affected;
+    }
+
+    std::vector<CellWindow> GridGraphBuilder::update_occupancy(const geometry::Scene& scene,
+                                                               std::span<const geometry::ObstacleDelta> deltas,
+                                                               GridOccupancy& occupancy) const {
+        PF_SCOPED_TIMER("grid.occupancy_update");
+        auto [grid_width, grid_height] = grid_size(scene);
+        if (occupancy.width() != grid_width || occupancy.height() != grid_height) {
+            occupancy = build_occupancy(scene);
+            return {{0, 0, grid_width - 1, grid_height - 1}};
+        }
+        if (occupancy.cell_count() == 0) {
+            return {};
+        }
+
+        // A moved disk is refreshed where it was and where it is, not over the
+        // box spanning both
+        std::vector<CellWindow> windows;
+        windows.reserve(deltas.size());
+        for (const auto& delta : deltas) {
+            if (delta.kind == geometry::ObstacleDelta::Kind::Moved) {
+                windows.push_back(delta_window(geometry::ObstacleDelta::removed(delta.before), occupancy));
+                windows.push_back(delta_window(geometry::ObstacleDelta::added(delta.after), occupancy));
+            } else {
+                windows.push_back(delta_window(delta, occupancy));
+            }
+        }
+        for (const auto& window : windows) {
+            refresh_occupancy(scene, window, occupancy);
+        }
+        return windows;
+    }
+
+    CellWindow GridGraphBuilder::delta_window(const geometry::ObstacleDelta& delta,
+                                              const GridOccupancy& occupancy) const {
+        // Bounding box of the disk positions the delta touches
+        double min_x = std::numeric_limits<double>::max();
+        double min_y = std::numeric_limits<double>::max();
+        double max_x = std::numeric_limits<double>::lowest();
+        double max_y = std::numeric_limits<double>::lowest();
+        auto extend = [&](const geometry::Disk& disk) {
+            min_x = std::min(min_x, disk.center.x - disk.radius);
+            min_y = std::min(min_y, disk.center.y - disk.radius);
+            max_x = std::max(max_x, disk.center.x + disk.radius);
+            max_y = std::max(max_y, disk.center.y + disk.radius);
+        };
+        if (delta.kind != geometry::ObstacleDelta::Kind::Added) {
+            extend(delta.before);
+        }
+        if (delta.kind != geometry::ObstacleDelta::Kind::Removed) {
+            extend(delta.after);
+        }
+
+        // Cells whose center or edges reach into the box: edges run one
+        // step from the cell center
+        const int width = occupancy.width();
+        const int height = occupancy.height();
+        return {
+            std::clamp(static_cast<int>(std::floor(min_x / grid_step_)) - 1, 0, width - 1),
+            std::clamp(static_cast<int>(std::floor(min_y / grid_step_)) - 1, 0, height - 1),
+            std::clamp(static_cast<int>(std::ceil(max_x / grid_step_)), 0, width - 1),
+            std::clamp(static_cast<int>(std::ceil(max_y / grid_step_)), 0, height - 1)
+        };
+    }
+
+    void GridGraphBuilder::refresh_occupancy(const geometry::Scene& scene, const CellWindow& window,
+                                             GridOccupancy& occupancy) const {
+        const int x0 = window.x0;
+        const int y0 = window.y0;
+        const int x1 = window.x1;
+        const int y1 = window.y1;
+        for (int layer = 0; layer < GridOccupancy::LayerCount; ++layer) {
+            for (int gy = y0; gy <= y1; ++gy) {
+                occupancy.set_blocked_range(static_cast<GridOccupancy::Layer>(layer),
+                                            occupancy.index(x0, gy), occupancy.index(x1, gy), false);
+            }
+        }
+        for (int gy = y0; gy <= y1; ++gy) {
+            for (int gx = x0; gx <= x1; ++gx) {
+                if (!is_point_in_bounds(grid_to_point(gx, gy), scene)) {
+                    occupancy.set_blocked(GridOccupancy::Cell, occupancy.index(gx, gy));
+                }
+            }
+        }
+
+        // Every disk reaching a center or an edge of the window's cells, clipped
+        // to the window; the edges stick out of the window by up to one step
+        const double window_x0 = (x0 - 1) * grid_step_;
+        const double window_y0 = (y0 - 1) * grid_step_;
+        const double window_x1 = (x1 + 2) * grid_step_;
+        const double window_y1 = (y1 + 2) * grid_step_;
+        const int num_layers = allow_diagonal_ ? 5 : 3;
+        for (const auto& obstacle : scene.obstacles) {
+            if (obstacle.center.x + obstacle.radius < window_x0 || obstacle.center.x - obstacle.radius > window_x1 ||
+                obstacle.center.y + obstacle.radius < window_y0 || obstacle.center.y - obstacle.radius > window_y1) {
+                continue;
+            }
+            for (int l = 0; l < num_layers; ++l) {
+                rasterize_disk(obstacle, LAYERS[l].layer, LAYERS[l].vx, LAYERS[l].vy,
+                               y0, y1 + 1, x0, x1 + 1, occupancy);
+            }
+        }
+    }
+
+    std::uint16_t GridGraphBuilder::connectivity(int gx, int gy) const {
+        // Bit 0: the cell is free; bit 1 + dir: the edge in direction dir exists
+        if (!occupancy_.is_cell_free(gx, gy)) {
+            return 0;
+        }
+        const int num_directions = allow_diagonal_ ? 8 : 4;
+        std::uint16_t mask = 1;
+        for (int dir = 0; dir < num_directions; ++dir) {
+            if (occupancy_.is_edge_free(gx, gy, dir)) {
+                mask |= static_cast<std::uint16_t>(2u << dir);
+            }
+        }
+        return mask;
+    }
+
+    ImplicitGridGraph GridGraphBuilder::build_implicit(const geometry::Scene& scene) const {
+        return {build_occupancy(scene), grid_step_, allow_diagonal_, snap_radius_};
+    }
+
+    GridOccupancy GridGraphBuilder::build_occupancy(const geometry::Scene& scene) const {
+        PF_SCOPED_TIMER("grid.occupancy");
+        auto [grid_width, grid_height] = grid_size(scene);
+        GridOccupancy occupancy(grid_width, grid_height);
+
+        // Cells whose center falls outside the scene; only the last column and
+        // row can, when the scene size is not a multiple of the grid step
+        auto block_if_out_of_bounds = [&](int gx, int gy) {
+            if (!is_point_in_bounds(grid_to_point(gx, gy), scene)) {
+                occupancy.set_blocked(GridOccupancy::Cell, occupancy.index(gx, gy));
+            }
+        };
+        for (int gy = 0; gy < grid_height; ++gy) {
+            block_if_out_of_bounds(grid_width - 1, gy);
+        }
+        for (int gx = 0; gx < grid_width; ++gx) {
+            block_if_out_of_bounds(gx, grid_height - 1);
+        }
+
+        const int num_layers = allow_diagonal_ ? 5 : 3;
+
+        // Each tile rasterizes the part of every disk that falls in its rows
+        const std::vector<int> tiles = row_tiles(occupancy);
+        run_tiles(tiles.size() - 1, [&](std::size_t tile) {
+            for (const auto& obstacle : scene.obstacles) {
+                for (int l = 0; l < num_layers; ++l) {
+                    rasterize_disk(obstacle, LAYERS[l].layer, LAYERS[l].vx, LAYERS[l].vy,
+                                   tiles[tile], tiles[tile + 1], 0, grid_width, occupancy);
+                }
+            }
+        });
+
+        PF_COUNT(bytes_allocated, occupancy.memory_bytes());
+        return occupancy;
+    }
+
+    void GridGraphBuilder::rasterize_disk(const geometry::Disk& disk, GridOccupancy::Layer layer,
+                                          int vx, int vy, int row_first, int row_last,
+                                          int column_first, int column_last, GridOccupancy& occupancy) const {
+        const int grid_width = occupancy.width();
+        const double sx = vx * grid_step_;
+        const double sy = vy * grid_step_;
+        [[maybe_unused]] std::uint64_t tests = 0;
+        auto touches = [&](int gx, int gy) {
+            ++tests;
+            geometry::Point from = grid_to_point(gx, gy);
+            return disk.intersects_segment(from, geometry::Point(from.x + sx, from.y + sy));
+        };
+
+        // The centers whose segment touches the disk form a capsule: the
+        // segment [c - v, c] widened by the radius. Each row of centers cuts it
+        // in one span, the union of the chords of both end disks and of the
+        // band along the axis.
+        const double r = disk.radius;
+        const double cx = disk.center.x;
+        const double cy = disk.center.y;
+        const double ax = cx - sx;
+        const double ay = cy - sy;
+        const double length = std::hypot(sx, sy);
+        const double ux = length > 0.0 ? sx / length : 0.0;
+        const double uy = length > 0.0 ? sy / length : 0.0;
+
+        int row_begin = static_cast<int>(std::ceil((std::min(ay, cy) - r) / grid_step_ - 0.5));
+        int row_end = static_cast<int>(std::floor((std::max(ay, cy) + r) / grid_step_ - 0.5));
+        row_begin = std::max(row_begin, row_first);
+        row_end = std::min(row_end, row_last - 1);
+
+        for (int gy = row_begin; gy <= row_end; ++gy) {
+            const double y = (gy + 0.5) * grid_step_;
+            double span_first = std::numeric_limits<double>::infinity();
+            double span_last = -std::numeric_limits<double>::infinity();
+            auto add_chord = [&](double ex, double ey) {
+                double half_chord_sq = r * r - (y - ey) * (y - ey);
+                if (half_chord_sq >= 0.0) {
+                    double half_chord = std::sqrt(half_chord_sq);
+                    span_first = std::min(span_first, ex - half_chord);
+                    span_last = std::max(span_last, ex + half_chord);
+                }
+            };
+            add_chord(cx, cy);
+            if (length > 0.0) {
+                add_chord(ax, ay);
+
+                // Projection on the axis within [0, length], distance from it
+                // at most r; both are linear in x along the row
+                double band_first = -std::numeric_limits<double>::infinity();
+                double band_last = std::numeric_limits<double>::infinity();
+                clip_linear(ux, (y - ay) * uy - ax * ux, 0.0, length, band_first, band_last);
+                clip_linear(-uy, (y - ay) * ux + ax * uy, -r, r, band_first, band_last);
+                if (band_first <= band_last) {
+                    span_first = std::min(span_first, band_first);
+                    span_last = std::max(span_last, band_last);
+                }
+            }
+            if (span_first > span_last) {
+                // Rounding at the top or bottom of the capsule; the nudging
+                // below still finds a span next to the nearer end
+                span_first = span_last = std::abs(y - cy) <= std::abs(y - ay) ? cx : ax;
+            }
+
+            // Scanline span, then nudged so that it agrees exactly with
+            // Disk::intersects_segment at both ends
+            int first = static_cast<int>(std::ceil(span_first / grid_step_ - 0.5));
+            int last = static_cast<int>(std::floor(span_last / grid_step_ - 0.5));
+            first = std::clamp(first, 0, grid_width);
+            last = std::clamp(last, -1, grid_width - 1);
+
+            while (first <= last && !touches(first, gy)) {
+                ++first;
+            }
+            while (first > 0 && touches(first - 1, gy)) {
+                --first;
+            }
+            while (last >= first && !touches(last, gy)) {
+                --last;
+            }
+            while (last + 1 < grid_width && last >= first && touches(last + 1, gy)) {
+                ++last;
+            }
+            first = std::max(first, column_first);
+            last = std::min(last, column_last - 1);
+            if (first > last) {
+                continue;
+            }
+
+            occupancy.set_blocked_range(layer, occupancy.index(first, gy), occupancy.index(last, gy));
+        }
+        PF_COUNT(obstacle_tests, tests);
+    }
+
+    std::pair<int, int> GridGraphBuilder::grid_size(const geometry::Scene& scene) const {
+        return {static_cast<int>(std::ceil(scene.width / grid_step_)),
+                static_cast<int>(std::ceil(scene.height / grid_step_))};
+    }
+
+    void GridGraphBuilder::create_nodes(const GridOccupancy& occupancy, const std::vector<int>& tiles) {
+        PF_SCOPED_TIMER("grid.nodes");
+        if (occupancy.cell_count() >= INVALID_NODE) {
+            throw std::length_error("Grid has too many cells for 32-bit node ids");
+        }
+
+        // Reset previous mappings
+        grid_width_ = occupancy.width();
+        grid_height_ = occupancy.height();
+        cell_to_node_.assign(occupancy.cell_count(), INVALID_NODE);
+
+        // Free cells per tile; the prefix sum gives each tile its first node id,
+        // so ids come out in row-major order whatever the number of threads
+        const std::size_t tile_count = tiles.size() - 1;
+        std::vector<std::size_t> first_node(tile_count + 1, 0);
+        run_tiles(tile_count, [&](std::size_t tile) {
+            std::size_t count = 0;
+            for (int gy = tiles[tile]; gy < tiles[tile + 1]; ++gy) {
+                for (int gx = 0; gx < occupancy.width(); ++gx) {
+                    count += occupancy.is_cell_free(gx, gy);
+                }
+            }
+            first_node[tile + 1] = count;
+        });
+        std::partial_sum(first_node.begin(), first_node.end(), first_node.begin());
+
+        node_to_point_.resize(first_node.back());
+        run_tiles(tile_count, [&](std::size_t tile) {
+            auto next = static_cast<NodeId>(first_node[tile]);
+            for (int gy = tiles[tile]; gy < tiles[tile + 1]; ++gy) {
+                for (int gx = 0; gx < occupancy.width(); ++gx) {
+                    if (!occupancy.is_cell_free(gx, gy)) {
+                        continue;
+                    }
+                    cell_to_node_[occupancy.index(gx, gy)] = next;
+                    node_to_point_[next++] = grid_to_point(gx, gy);
+                }
+            }
+        });
+    }
+
+    std::vector<int> GridGraphBuilder::row_tiles(const GridOccupancy& occupancy) const {
+        // Tile boundaries fall on rows that start a fresh 64-bit word in every
+        // occupancy layer, so concurrent tiles never write to the same word
+        const int alignment = 64 / std::gcd(std::max(occupancy.width(), 1), 64);
+        const int threads = static_cast<int>(resolved_thread_count());
+        int rows_per_tile = (occupancy.height() + threads - 1) / threads;
+        rows_per_tile = std::max(alignment, (rows_per_tile + alignment - 1) / alignment * alignment);
+
+        std::vector<int> bounds{0};
+        while (bounds.back() < occupancy.height()) {
+            bounds.push_back(std::min(occupancy.height(), bounds.back() + rows_per_tile));
+        }
+        return bounds;
+    }
+
+    unsigned GridGraphBuilder::resolved_thread_count() const {
+        if (thread_count_ != 0) {
+            return thread_count_;
+        }
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    int GridGraphBuilder::collect_edges(const GridOccupancy& occupancy, int gx, int gy, Graph::Edge* out) const {
+        const int num_directions = allow_diagonal_ ? 8 : 4;
+        geometry::Point from_point = grid_to_point(gx, gy);
+        int count = 0;
+
+        // Check each neighbor direction; the occupancy bitmap already holds the
+        // segment test of every edge
+        for (int dir = 0; dir < num_directions; ++dir) {
+            if (!occupancy.is_edge_free(gx, gy, dir)) {
+                continue;
+            }
+
+            int nx = gx + GridOccupancy::dx[dir];
+            int ny = gy + GridOccupancy::dy[dir];
+            NodeId to_node = cell_to_node_[occupancy.index(nx, ny)];
+
+            // Neighbour visits this cell from its own side, so the reverse edge
+            // is added when that cell is processed
+            out[count++] = {to_node, calculate_distance(from_point, grid_to_point(nx, ny))};
+        }
+        return count;
     }
 
     std::string GridGraphBuilder::name() const {
         return "GridGraphBuilder";
     }
 
-    geometry::Point GridGraphBuilder::get_node_point(std::size_t node_id) const {
+    geometry::Point GridGraphBuilder::get_node_point(NodeId node_id) const {
         if (node_id >= node_to_point_.size()) {
             throw std::out_of_range("Node ID out of range");
         }
         return node_to_point_[node_id];
     }
 
-    std::optional<std::size_t> GridGraphBuilder::get_node_id(const geometry::Point& point) const {
-        // Find the closest grid cell
-        int grid_x = static_cast<int>(std::round(point.x / grid_step_));
-        int grid_y = static_cast<int>(std::round(point.y / grid_step_));
-        
-        // This is a simplified lookup - in a full implementation, you might want
-        // a more sophisticated spatial index. For now, we'll search through all nodes.
-        double min_distance = std::numeric_limits<double>::max();
-        std::size_t closest_node = 0;
-        bool found = false;
-
-        for (std::size_t i = 0; i < node_to_point_.size(); ++i) {
-            double dist = node_to_point_[i].distance(point);
-            if (dist < min_distance) {
-                min_distance = dist;
-                closest_node = i;
-                found = true;
-            }
+    std::optional<NodeId> GridGraphBuilder::get_node_id(const geometry::Point& point) const {
+        // Cell containing the point; if it is blocked (or outside the grid), the
+        // nearest free cell center within snap_radius_ rings of cells
+        auto cell = find_nearest_cell(grid_width_, grid_height_, grid_step_, point, snap_radius_,
+                                      [this](int gx, int gy) {
+                                          return occupancy_.is_cell_free(gx, gy);
+                                      });
+        if (!cell) {
+            return std::nullopt;
         }
+        return cell_to_node_[static_cast<std::size_t>(cell->second) * grid_width_ + cell->first];
+    }
 
-        // Return node if it's close enough (within half a grid step)
-        if (found && min_distance < grid_step_ / 2.0) {
-            return closest_node;
+    std::vector<std::optional<NodeId>> GridGraphBuilder::get_node_ids(std::span<const geometry::Point> points) const {
+        std::vector<std::optional<NodeId>> nodes;
+        nodes.reserve(points.size());
+        for (const auto& point : points) {
+            nodes.push_back(get_node_id(point));
         }
-        return std::nullopt;
+        return nodes;
     }
 
-    bool GridGraphBuilder::is_point_in_obstacle(const geometry::Point& point, const geometry::Scene& scene) const {
-        for (const auto& obstacle : scene.obstacles) {
-            if (obstacle.contains(point)) {
-                return true;
-            }
+    void GridGraphBuilder::set_thread_count(unsigned threads) {
+        thread_count_ = threads;
+    }
+
+    void GridGraphBuilder::set_snap_radius(int cells) {
+        if (cells < 0) {
+            throw std::invalid_argument("Snap radius must be non-negative");
         }
-        return false;
+        snap_radius_ = cells;
     }
 
     bool GridGraphBuilder::is_point_in_bounds(const geometry::Point& point, const geometry::Scene& scene) const {
@@ -0,0 +1,655 @@
+//
+// Implementation of TangentGraphBuilder
+//
+
+#include "../../include/algorithms/TangentGraphBuilder.h"
+#include "../../include/algorithms/Instrumentation.h"
+#include "../../include/geometry/VisibilitySweep.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace algorithms::graph {
+
+    namespace {
+
+        constexpr double PI = 3.14159265358979323846;
+        constexpr double TWO_PI = 2.0 * PI;
+
+        // Slack for contacts that are exact in theory: tangent segments grazing a
+        // disk and arcs ending on another disk's boundary are not blocked
+        constexpr double EPSILON = 1e-9;
+
+        struct Tangent {
+            geometry::Point first;
+            geometry::Point second;
+        };
+
+        /**
+         * Tangent segments between circles (c1, r1) and (c2, r2).
+         * Outer tangents keep both circles on the same side of the line, inner
+         * tangents separate them; r1 = 0 gives the tangents from a point.
+         */
+        int circle_tangents(const geometry::Point& c1, double r1, const geometry::Point& c2, double r2,
+                            bool inner, Tangent* out) {
+            double dx = c2.x - c1.x;
+            double dy = c2.y - c1.y;
+            double d = std::hypot(dx, dy);
+            double signed_r2 = inner ? -r2 : r2;
+            if (d <= 0.0) {
+                return 0;
+            }
+            double cos_a = (r1 - signed_r2) / d;
+            if (std::abs(cos_a) >= 1.0) {
+                return 0;
+            }
+            double sin_a = std::sqrt(1.0 - cos_a * cos_a);
+            double ux = dx / d;
+            double uy = dy / d;
+
+            int count = 0;
+            for (double side : {1.0, -1.0}) {
+                // Unit normal of the tangent line
+                double nx = ux * cos_a - side * uy * sin_a;
+                double ny = uy * cos_a + side * ux * sin_a;
+                out[count++] = {{c1.x + r1 * nx, c1.y + r1 * ny},
+                                {c2.x + signed_r2 * nx, c2.y + signed_r2 * ny}};
+            }
+            return count;
+        }
+
+        std::uint64_t arc_key(NodeId from, NodeId to) {
+            return (static_cast<std::uint64_t>(from) << 32) | to;
+        }
+
+    }
+
+    TangentGraphBuilder::TangentGraphBuilder(double arc_step)
+        : arc_step_(arc_step) {
+        if (arc_step <= 0) {
+            throw std::invalid_argument("Arc step must be positive");
+        }
+    }
+
+    Graph TangentGraphBuilder::build(const geometry::Scene& scene) {
+        nodes_.clear();
+        arc_sweeps_.clear();
+        disks_ = scene.obstacles;
+        disk_nodes_.assign(disks_.size(), {});
+
+        geometry::DiskIndex obstacles(scene.obstacles);
+        std::vector<PendingEdge> edges;
+
+        add_node(scene.start, NO_DISK);
+        add_node(scene.goal, NO_DISK);
+
+        // Direct line of sight between the terminals
+        if (is_segment_clear(scene.start, scene.goal, NO_DISK, NO_DISK, obstacles)) {
+            edges.push_back({START_NODE, GOAL_NODE, scene.start.distance(scene.goal)});
+        }
+
+        // Tangents from start and goal to every disk, filtered by one rotational
+        // sweep per terminal instead of a segment query per tangent
+        Tangent tangents[2];
+        geometry::VisibilitySweep sweep(scene.obstacles);
+        std::vector<bool> visible;
+        {
+            PF_SCOPED_TIMER("tangent.terminals");
+            std::vector<geometry::VisibilitySweep::Target> targets;
+            for (NodeId terminal : {START_NODE, GOAL_NODE}) {
+                const geometry::Point from = nodes_[terminal].point;
+                if (obstacles.contains(from)) {
+                    continue;
+                }
+                targets.clear();
+                for (std::size_t i = 0; i < disks_.size(); ++i) {
+                    int count = circle_tangents(from, 0.0, disks_[i].center, disks_[i].radius, false, tangents);
+                    for (int t = 0; t < count; ++t) {
+                        targets.push_back({tangents[t].second, i});
+                    }
+                }
+                sweep.visible_from(from, targets, visible);
+                for (std::size_t t = 0; t < targets.size(); ++t) {
+                    if (visible[t]) {
+                        add_segment(terminal, add_node(targets[t].point, targets[t].disk), edges);
+                    }
+                }
+            }
+        }
+
+        // Outer and inner bitangents of every pair of disks, filtered by the
+        // tangent sweeps round each disk
+        {
+            PF_SCOPED_TIMER("tangent.bitangents");
+            std::vector<geometry::VisibilitySweep::TangentTarget> targets;
+            for (std::size_t i = 0; i < disks_.size(); ++i) {
+                targets.clear();
+                for (std::size_t j = i + 1; j < disks_.size(); ++j) {
+                    for (bool inner : {false, true}) {
+                        int count = circle_tangents(disks_[i].center, disks_[i].radius,
+                                                    disks_[j].center, disks_[j].radius, inner, tangents);
+                        for (int t = 0; t < count; ++t) {
+                            targets.push_back({tangents[t].first, tangents[t].second, j});
+                        }
+                    }
+                }
+                if (targets.empty()) {
+                    continue;
+                }
+                sweep.visible_along_tangents(i, targets, visible);
+                for (std::size_t t = 0; t < targets.size(); ++t) {
+                    if (visible[t]) {
+                        NodeId first = add_node(targets[t].from, i);
+                        add_segment(first, add_node(targets[t].to, targets[t].disk), edges);
+                    }
+                }
+            }
+        }
+
+        add_arc_edges(obstacles, edges);
+
+        // Every edge is undirected
+        Graph graph;
+        graph.adj.resize(nodes_.size());
+        for (const auto& edge : edges) {
+            graph.adj[edge.from].push_back({edge.to, edge.weight});
+            graph.adj[edge.to].push_back({edge.from, edge.weight});
+        }
+        PF_COUNT(bytes_allocated, graph.memory_bytes());
+        return graph;
+    }
+
+    std::vector<std::size_t> TangentGraphBuilder::update(const geometry::Scene& scene,
+                                                         std::span<const geometry::ObstacleDelta> deltas,
+                                                         Graph& graph) {
+        if (nodes_.size() < 2 || graph.adj.size() != nodes_.size() ||
+            !(scene.start == nodes_[START_NODE].point) || !(scene.goal == nodes_[GOAL_NODE].point)) {
+            return GraphBuilder::update(scene, deltas, graph);
+        }
+
+        // Match the disks of the last build to the scene's by id: changed disks
+        // leave their old position (vacated) and take a new one (placed)
+        std::unordered_map<std::size_t, std::size_t> old_position;
+        std::unordered_map<std::size_t, std::size_t> new_position;
+        for (std::size_t i = 0; i < disks_.size(); ++i) {
+            old_position.emplace(disks_[i].id, i);
+        }
+        for (std::size_t i = 0; i < scene.obstacles.size(); ++i) {
+            new_position.emplace(scene.obstacles[i].id, i);
+        }
+        if (old_position.size() != disks_.size() || new_position.size() != scene.obstacles.size()) {
+            return GraphBuilder::update(scene, deltas, graph); // ids are not unique
+        }
+        std::vector<bool> changed(disks_.size(), false);
+        std::vector<bool> is_placed(scene.obstacles.size(), false);
+        std::vector<geometry::Disk> vacated;
+        std::vector<std::size_t> placed;
+        for (const auto& delta : deltas) {
+            using Kind = geometry::ObstacleDelta::Kind;
+            if (delta.kind != Kind::Added) {
+                auto it = old_position.find(delta.before.id);
+                if (it == old_position.end() || changed[it->second]) {
+                    return GraphBuilder::update(scene, deltas, graph);
+                }
+                changed[it->second] = true;
+                vacated.push_back(disks_[it->second]);
+            }
+            if (delta.kind != Kind::Removed) {
+                auto it = new_position.find(delta.after.id);
+                if (it == new_position.end() || is_placed[it->second]) {
+                    return GraphBuilder::update(scene, deltas, graph);
+                }
+                is_placed[it->second] = true;
+                placed.push_back(it->second);
+            }
+        }
+        std::vector<std::size_t> moved_to(disks_.size(), NO_DISK);
+        for (std::size_t i = 0; i < disks_.size(); ++i) {
+            if (changed[i]) {
+                continue;
+            }
+            auto it = new_position.find(disks_[i].id);
+            if (it == new_position.end() || is_placed[it->second]) {
+                return GraphBuilder::update(scene, deltas, graph);
+            }
+            moved_to[i] = it->second;
+        }
+        if (disks_.size() - vacated.size() + placed.size() != scene.obstacles.size()) {
+            return GraphBuilder::update(scene, deltas, graph);
+        }
+        if (deltas.empty()) {
+            return {};
+        }
+
+        // Renumber the surviving tangent nodes to the new disk positions
+        std::vector<NodeId> orphans;
+        disks_ = scene.obstacles;
+        disk_nodes_.assign(disks_.size(), {});
+        for (NodeId n = GOAL_NODE + 1; n < nodes_.size(); ++n) {
+            TangentNode& node = nodes_[n];
+            if (node.disk == NO_DISK) {
+                continue;
+            }
+            if (changed[node.disk]) {
+                node.disk = NO_DISK;
+                orphans.push_back(n);
+            } else {
+                node.disk = moved_to[node.disk];
+                disk_nodes_[node.disk].push_back(n);
+            }
+        }
+
+        geometry::DiskIndex obstacles(scene.obstacles);
+        geometry::DiskIndex vacated_index(vacated);
+        std::vector<geometry::Disk> placed_disks;
+        for (std::size_t i : placed) {
+            placed_disks.push_back(disks_[i]);
+        }
+        geometry::DiskIndex placed_index(placed_disks);
+
+        std::vector<std::size_t> affected;
+        // Disks whose arcs have to be redone: their nodes or their overlaps changed
+        std::vector<bool> dirty(disks_.size(), false);
+        for (std::size_t i : placed) {
+            dirty[i] = true;
+        }
+        for (const std::vector<geometry::Disk>* moved : {&vacated, &placed_disks}) {
+            for (const auto& disk : *moved) {
+                obstacles.for_each_candidate(
+                    {disk.center.x - disk.radius, disk.center.y - disk.radius},
+                    {disk.center.x + disk.radius, disk.center.y + disk.radius},
+                    [&](std::size_t k) {
+                        if (disk.center.distance(disks_[k].center) < disk.radius + disks_[k].radius) {
+                            dirty[k] = true;
+                        }
+                    });
+            }
+        }
+
+        auto detach = [&](NodeId u) {
+            for (const auto& edge : graph.adj[u]) {
+                std::erase_if(graph.adj[edge.to], [u](const Graph::Edge& back) { return back.to == u; });
+                arc_sweeps_.erase(arc_key(u, static_cast<NodeId>(edge.to)));
+                arc_sweeps_.erase(arc_key(static_cast<NodeId>(edge.to), u));
+                affected.push_back(edge.to);
+            }
+            graph.adj[u].clear();
+            affected.push_back(u);
+        };
+        // Drops a tangent node's segment, which leaves both its ends dead
+        auto drop_segment = [&](NodeId u) {
+            for (NodeId n : {u, nodes_[u].partner}) {
+                if (n == START_NODE || n == GOAL_NODE) {
+                    continue;
+                }
+                if (nodes_[n].disk != NO_DISK) {
+                    dirty[nodes_[n].disk] = true;
+                    nodes_[n].disk = NO_DISK;
+                }
+                detach(n);
+            }
+        };
+
+        // Segments and arcs of the changed disks go away with their nodes
+        for (NodeId n : orphans) {
+            drop_segment(n);
+        }
+
+        // Segments now crossing a placed disk
+        auto crosses_placed = [&](const geometry::Point& a, const geometry::Point& b,
+                                  std::size_t skip_first, std::size_t skip_second) {
+            return placed_index.any_intersecting(a, b, EPSILON, [&](std::size_t k) {
+                return placed[k] != skip_first && placed[k] != skip_second;
+            });
+        };
+        for (NodeId n = GOAL_NODE + 1; n < nodes_.size(); ++n) {
+            const TangentNode& node = nodes_[n];
+            if (node.disk == NO_DISK || (node.partner > GOAL_NODE && node.partner < n)) {
+                continue;
+            }
+            const TangentNode& other = nodes_[node.partner];
+            if (crosses_placed(node.point, other.point, node.disk, other.disk)) {
+                drop_segment(n);
+            }
+        }
+        std::vector<PendingEdge> edges;
+        auto& start_edges = graph.adj[START_NODE];
+        bool direct = std::any_of(start_edges.begin(), start_edges.end(),
+                                  [](const Graph::Edge& edge) { return edge.to == GOAL_NODE; });
+        if (direct && crosses_placed(scene.start, scene.goal, NO_DISK, NO_DISK)) {
+            std::erase_if(start_edges, [](const Graph::Edge& edge) { return edge.to == GOAL_NODE; });
+            std::erase_if(graph.adj[GOAL_NODE], [](const Graph::Edge& edge) { return edge.to == START_NODE; });
+            affected.push_back(START_NODE);
+            affected.push_back(GOAL_NODE);
+        } else if (!direct && vacated_index.any_intersecting(scene.start, scene.goal, EPSILON,
+                                                                [](std::size_t) { return true; }) &&
+                   is_segment_clear(scene.start, scene.goal, NO_DISK, NO_DISK, obstacles)) {
+            edges.push_back({START_NODE, GOAL_NODE, scene.start.distance(scene.goal)});
+        }
+
+        auto add_if_clear = [&](NodeId terminal, const geometry::Point& from, std::size_t from_disk,
+                                const geometry::Point& to, std::size_t to_disk) {
+            if (!is_segment_clear(from, to, from_disk, to_disk, obstacles)) {
+                return;
+            }
+            NodeId first = terminal != INVALID_NODE ? terminal : add_node(from, from_disk);
+            add_segment(first, add_node(to, to_disk), edges);
+            if (from_disk != NO_DISK) {
+                dirty[from_disk] = true;
+            }
+            dirty[to_disk] = true;
+        };
+        auto crosses_vacated = [&](const geometry::Point& a, const geometry::Point& b) {
+            return vacated_index.any_intersecting(a, b, EPSILON, [](std::size_t) { return true; });
+        };
+
+        // Tangents of the other disks that only the vacated positions blocked
+        Tangent tangents[2];
+        {
+            PF_SCOPED_TIMER("tangent.update_vacated");
+            for (NodeId terminal : {START_NODE, GOAL_NODE}) {
+                const geometry::Point from = nodes_[terminal].point;
+                if (vacated.empty() || obstacles.contains(from)) {
+                    continue;
+                }
+                for (std::size_t i = 0; i < disks_.size(); ++i) {
+                    if (is_placed[i]) {
+                        continue;
+                    }
+                    int count = circle_tangents(from, 0.0, disks_[i].center, disks_[i].radius, false, tangents);
+                    for (int t = 0; t < count; ++t) {
+                        if (crosses_vacated(from, tangents[t].second)) {
+                            add_if_clear(terminal, from, NO_DISK, tangents[t].second, i);
+                        }
+                    }
+                }
+            }
+
+            // The bitangents of a pair stay within max(r_i, r_j) of the segment between the centers
+            for (std::size_t i = 0; i < disks_.size() && !vacated.empty(); ++i) {
+                if (is_placed[i]) {
+                    continue;
+                }
+                for (std::size_t j = i + 1; j < disks_.size(); ++j) {
+                    if (is_placed[j]) {
+                        continue;
+                    }
+                    const double reach = std::max(disks_[i].radius, disks_[j].radius);
+                    bool near = std::any_of(vacated.begin(), vacated.end(), [&](const geometry::Disk& disk) {
+                        return disk.distance_to_segment(disks_[i].center, disks_[j].center) < disk.radius + reach;
+                    });
+                    if (!near) {
+                        continue;
+                    }
+                    for (bool inner : {false, true}) {
+                        int count = circle_tangents(disks_[i].center, disks_[i].radius,
+                                                    disks_[j].center, disks_[j].radius, inner, tangents);
+                        for (int t = 0; t < count; ++t) {
+                            if (crosses_vacated(tangents[t].first, tangents[t].second)) {
+                                add_if_clear(INVALID_NODE, tangents[t].first, i, tangents[t].second, j);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // All tangents of the placed disks, one sweep round each
+        if (!placed.empty()) {
+            PF_SCOPED_TIMER("tangent.update_placed");
+            geometry::VisibilitySweep sweep(scene.obstacles);
+            std::vector<geometry::VisibilitySweep::TangentTarget> targets;
+            std::vector<bool> visible;
+            for (std::size_t i : placed) {
+                for (NodeId terminal : {START_NODE, GOAL_NODE}) {
+                    const geometry::Point from = nodes_[terminal].point;
+                    if (obstacles.contains(from)) {
+                        continue;
+                    }
+                    int count = circle_tangents(from, 0.0, disks_[i].center, disks_[i].radius, false, tangents);
+                    for (int t = 0; t < count; ++t) {
+                        add_if_clear(terminal, from, NO_DISK, tangents[t].second, i);
+                    }
+                }
+
+                // A pair of placed disks is handled from the lower position
+                targets.clear();
+                for (std::size_t j = 0; j < disks_.size(); ++j) {
+                    if (j == i || (is_placed[j] && j < i)) {
+                        continue;
+                    }
+                    for (bool inner : {false, true}) {
+                        int count = circle_tangents(disks_[i].center, disks_[i].radius,
+                                                    disks_[j].center, disks_[j].radius, inner, tangents);
+                        for (int t = 0; t < count; ++t) {
+                            targets.push_back({tangents[t].first, tangents[t].second, j});
+                        }
+                    }
+                }
+                if (targets.empty()) {
+                    continue;
+                }
+                sweep.visible_along_tangents(i, targets, visible);
+                for (std::size_t t = 0; t < targets.size(); ++t) {
+                    if (visible[t]) {
+                        NodeId first = add_node(targets[t].from, i);
+                        add_segment(first, add_node(targets[t].to, targets[t].disk), edges);
+                        dirty[targets[t].disk] = true;
+                    }
+                }
+            }
+        }
+
+        // Redo the arcs of the dirty disks over their live nodes
+        graph.adj.resize(nodes_.size());
+        for (std::size_t i = 0; i < disks_.size(); ++i) {
+            if (!dirty[i]) {
+                continue;
+            }
+            std::erase_if(disk_nodes_[i], [&](NodeId n) { return nodes_[n].disk != i; });
+            for (NodeId n : disk_nodes_[i]) {
+                std::erase_if(graph.adj[n], [&](const Graph::Edge& edge) {
+                    return arc_sweeps_.erase(arc_key(n, static_cast<NodeId>(edge.to))) > 0;
+                });
+                affected.push_back(n);
+            }
+            add_disk_arcs(i, obstacles, edges);
+        }
+
+        for (const auto& edge : edges) {
+            graph.adj[edge.from].push_back({edge.to, edge.weight});
+            graph.adj[edge.to].push_back({edge.from, edge.weight});
+            affected.push_back(edge.from);
+            affected.push_back(edge.to);
+        }
+
+        std::sort(affected.begin(), affected.end());
+        affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+        return affected;
+    }
+
+    void TangentGraphBuilder::add_arc_edges(const geometry::DiskIndex& obstacles, std::vector<PendingEdge>& edges) {
+        PF_SCOPED_TIMER("tangent.arcs");
+        for (std::size_t i = 0; i < disks_.size(); ++i) {
+            add_disk_arcs(i, obstacles, edges);
+        }
+    }
+
+    void TangentGraphBuilder::add_disk_arcs(std::size_t i, const geometry::DiskIndex& obstacles,
+                                            std::vector<PendingEdge>& edges) {
+        struct Interval {
+            double center;
+            double half_width;
+        };
+
+        if (disk_nodes_[i].size() < 2) {
+            return;
+        }
+        const geometry::Disk& disk = disks_[i];
+
+        // Parts of this disk's boundary covered by overlapping disks
+        std::vector<Interval> blocked;
+        bool fully_covered = false;
+        obstacles.for_each_candidate(
+            {disk.center.x - disk.radius, disk.center.y - disk.radius},
+            {disk.center.x + disk.radius, disk.center.y + disk.radius},
+            [&](std::size_t k) {
+                if (k == i) {
+                    return;
+                }
+                const geometry::Disk& other = disks_[k];
+                double d = disk.center.distance(other.center);
+                if (d >= disk.radius + other.radius || d + other.radius <= disk.radius) {
+                    return; // apart, or strictly inside this disk
+                }
+                if (d + disk.radius <= other.radius) {
+                    fully_covered = true;
+                    return;
+                }
+                double cos_a = (disk.radius * disk.radius + d * d - other.radius * other.radius) /
+                               (2.0 * disk.radius * d);
+                blocked.push_back({std::atan2(other.center.y - disk.center.y, other.center.x - disk.center.x),
+                                   std::acos(std::clamp(cos_a, -1.0, 1.0))});
+            });
+        if (fully_covered) {
+            return;
+        }
+
+        auto is_arc_free = [&](double from_angle, double sweep) {
+            for (const auto& interval : blocked) {
+                double rel = std::fmod(interval.center - from_angle, TWO_PI);
+                if (rel < 0.0) {
+                    rel += TWO_PI;
+                }
+                for (double shift : {-TWO_PI, 0.0, TWO_PI}) {
+                    double lo = rel + shift - interval.half_width;
+                    double hi = rel + shift + interval.half_width;
+                    if (lo < sweep - EPSILON && hi > EPSILON) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        };
+
+        // Consecutive tangent points counter-clockwise around the disk
+        std::vector<NodeId> around = disk_nodes_[i];
+        std::sort(around.begin(), around.end(), [this](NodeId a, NodeId b) {
+            return nodes_[a].angle < nodes_[b].angle;
+        });
+
+        auto add_arc = [&](NodeId from, NodeId to, double sweep) {
+            arc_sweeps_[arc_key(from, to)] = sweep;
+            arc_sweeps_[arc_key(to, from)] = -sweep;
+            edges.push_back({from, to, disk.radius * sweep});
+        };
+
+        if (around.size() == 2) {
+            // Two arcs join the same pair of nodes: keep the shorter free one
+            double sweep = nodes_[around[1]].angle - nodes_[around[0]].angle;
+            bool forward_free = is_arc_free(nodes_[around[0]].angle, sweep);
+            bool backward_free = is_arc_free(nodes_[around[1]].angle, TWO_PI - sweep);
+            if (forward_free && (!backward_free || sweep <= TWO_PI - sweep)) {
+                add_arc(around[0], around[1], sweep);
+            } else if (backward_free) {
+                add_arc(around[1], around[0], TWO_PI - sweep);
+            }
+            return;
+        }
+
+        for (std::size_t k = 0; k < around.size(); ++k) {
+            NodeId from = around[k];
+            NodeId to = around[(k + 1) % around.size()];
+            double sweep = nodes_[to].angle - nodes_[from].angle;
+            if (sweep < 0.0) {
+                sweep += TWO_PI;
+            }
+            if (is_arc_free(nodes_[from].angle, sweep)) {
+                add_arc(from, to, sweep);
+            }
+        }
+    }
+
+    std::string TangentGraphBuilder::name() const {
+        return "TangentGraphBuilder";
+    }
+
+    void TangentGraphBuilder::append_edge_path(std::size_t from, std::size_t to,
+                                               std::vector<geometry::Point>& points) const {
+        auto it = arc_sweeps_.find(arc_key(static_cast<NodeId>(from), static_cast<NodeId>(to)));
+        if (it == arc_sweeps_.end()) {
+            return; // straight segment
+        }
+        const TangentNode& start = nodes_[from];
+        const geometry::Disk& disk = disks_[start.disk];
+        const double sweep = it->second;
+        const int segments = static_cast<int>(std::ceil(std::abs(sweep) / arc_step_));
+        for (int k = 1; k < segments; ++k) {
+            double angle = start.angle + sweep * k / segments;
+            points.emplace_back(disk.center.x + disk.radius * std::cos(angle),
+                                disk.center.y + disk.radius * std::sin(angle));
+        }
+    }
+
+    geometry::Point TangentGraphBuilder::get_node_point(NodeId node_id) const {
+        if (node_id >= nodes_.size()) {
+            throw std::out_of_range("Node ID out of range");
+        }
+        return nodes_[node_id].point;
+    }
+
+    std::optional<NodeId> TangentGraphBuilder::get_node_id(const geometry::Point& point) const {
+        if (nodes_.empty()) {
+            return std::nullopt;
+        }
+        if (point == nodes_[START_NODE].point) {
+            return START_NODE;
+        }
+        if (point == nodes_[GOAL_NODE].point) {
+            return GOAL_NODE;
+        }
+
+        NodeId closest = START_NODE;
+        double min_distance = nodes_[START_NODE].point.distance(point);
+        for (NodeId i = 1; i < nodes_.size(); ++i) {
+            if (i > GOAL_NODE && nodes_[i].disk == NO_DISK) {
+                continue; // dead since an update
+            }
+            double dist = nodes_[i].point.distance(point);
+            if (dist < min_distance) {
+                min_distance = dist;
+                closest = i;
+            }
+        }
+        return closest;
+    }
+
+    NodeId TangentGraphBuilder::add_node(const geometry::Point& point, std::size_t disk) {
+        double angle = 0.0;
+        if (disk != NO_DISK) {
+            angle = std::atan2(point.y - disks_[disk].center.y, point.x - disks_[disk].center.x);
+        }
+        auto node = static_cast<NodeId>(nodes_.size());
+        nodes_.push_back({point, disk, angle, INVALID_NODE});
+        if (disk != NO_DISK) {
+            disk_nodes_[disk].push_back(node);
+        }
+        return node;
+    }
+
+    void TangentGraphBuilder::add_segment(NodeId first, NodeId second, std::vector<PendingEdge>& edges) {
+        nodes_[first].partner = second;
+        nodes_[second].partner = first;
+        edges.push_back({first, second, nodes_[first].point.distance(nodes_[second].point)});
+    }
+
+    bool TangentGraphBuilder::is_segment_clear(const geometry::Point& a, const geometry::Point& b,
+                                               std::size_t skip_first, std::size_t skip_second,
+                                               const geometry::DiskIndex& obstacles) const {
+        PF_COUNT(obstacle_tests, 1);
+        return !obstacles.any_intersecting(a, b, EPSILON, [&](std::size_t k) {
+            return k != skip_first && k != skip_second;
+        });
+    }
+
+} // namespace algorithms::graph
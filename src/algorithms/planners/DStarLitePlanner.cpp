@@ -0,0 +1,257 @@
+//
+// Implementation of DStarLitePlanner
+//
+
+#include "../../include/algorithms/DStarLitePlanner.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace algorithms {
+
+    namespace {
+
+        constexpr double INF = std::numeric_limits<double>::infinity();
+
+        // Keys of nodes on the shortest path equal the start's key, but are
+        // summed in a different order; within this relative slack they still
+        // count as not larger, so the search does not stop one rounding early
+        constexpr double KEY_TOLERANCE = 1e-9;
+
+    }
+
+    DStarLitePlanner::DStarLitePlanner(std::shared_ptr<graph::GraphBuilder> builder, NodeLocator locator)
+        : GraphPlanner(std::move(builder), std::move(locator)) {
+        // The backward search walks adj[u] as the predecessors of u
+        if (!builder_->is_symmetric()) {
+            throw std::invalid_argument("D* Lite needs a builder with a symmetric graph");
+        }
+    }
+
+    std::string DStarLitePlanner::name() const {
+        return "D* Lite";
+    }
+
+    void DStarLitePlanner::reset() {
+        has_graph_ = false;
+        graph_.adj.clear();
+        obstacles_.clear();
+        search_graph_.points.clear();
+        open_.clear();
+        goal_ = graph::INVALID_NODE;
+        start_ = graph::INVALID_NODE;
+    }
+
+    PathResult DStarLitePlanner::find_path(const geometry::Scene& scene) {
+        expanded_ = 0;
+        bool restart = false;
+
+        if (!has_graph_ || scene.width != last_scene_.width || scene.height != last_scene_.height) {
+            {
+                PF_SCOPED_TIMER("dstar.build");
+                graph_ = builder_->build(scene);
+            }
+            has_graph_ = true;
+            restart = true;
+            search_graph_.points.clear();
+            sync_nodes();
+        } else {
+            std::vector<geometry::ObstacleDelta> deltas = geometry::diff_obstacles(obstacles_, scene.obstacles);
+            if (!deltas.empty() || !(scene.start == last_scene_.start) || !(scene.goal == last_scene_.goal)) {
+                // Builders whose graph depends on the endpoints rebuild here too
+                std::vector<std::size_t> affected;
+                {
+                    PF_SCOPED_TIMER("dstar.update");
+                    affected = builder_->update(scene, deltas, graph_);
+                }
+
+                // A rebuild reports every node and may have renumbered them
+                if (affected.size() == graph_.adj.size() || goal_ == graph::INVALID_NODE) {
+                    restart = true;
+                    search_graph_.points.clear();
+                    sync_nodes();
+                } else {
+                    sync_nodes();
+                    for (std::size_t u : affected) {
+                        auto node = static_cast<graph::NodeId>(u);
+                        if (node != goal_) {
+                            rhs_[node] = best_successor_cost(node);
+                        }
+                        update_vertex(node);
+                    }
+                }
+            }
+        }
+        obstacles_ = scene.obstacles;
+        last_scene_.start = scene.start;
+        last_scene_.goal = scene.goal;
+        last_scene_.width = scene.width;
+        last_scene_.height = scene.height;
+
+        auto start = locate(scene.start);
+        auto goal = locate(scene.goal);
+        if (!start || !goal) {
+            return std::nullopt;
+        }
+        if (restart || *goal != goal_) {
+            start_ = *start;
+            restart_search(*goal);
+        } else if (*start != start_) {
+            // Keys already in the open list stay valid lower bounds
+            key_modifier_ += heuristic_(search_graph_.points[start_], search_graph_.points[*start]);
+            start_ = *start;
+        }
+
+        compute_shortest_path();
+
+        std::vector<graph::NodeId> nodes;
+        Descent descent = extract_path(nodes);
+        if (descent == Descent::Stale) {
+            // A repair left a node on the way inconsistent; search again from scratch
+            restart_search(goal_);
+            compute_shortest_path();
+            nodes.clear();
+            descent = extract_path(nodes);
+            if (descent == Descent::Stale) {
+                throw std::logic_error("D* Lite left the path inconsistent after a full search");
+            }
+        }
+        if (descent != Descent::Found) {
+            return std::nullopt;
+        }
+        return make_path(scene.start, scene.goal, nodes);
+    }
+
+    void DStarLitePlanner::sync_nodes() {
+        // Node ids are stable across updates; new nodes are appended
+        const std::size_t node_count = graph_.adj.size();
+        for (std::size_t i = search_graph_.points.size(); i < node_count; ++i) {
+            search_graph_.points.push_back(locator_.node_point(i));
+        }
+        g_.resize(node_count, INF);
+        rhs_.resize(node_count, INF);
+        queued_key_.resize(node_count);
+        queued_.resize(node_count, 0);
+    }
+
+    void DStarLitePlanner::restart_search(graph::NodeId goal) {
+        const std::size_t node_count = graph_.adj.size();
+        g_.assign(node_count, INF);
+        rhs_.assign(node_count, INF);
+        queued_.assign(node_count, 0);
+
+        open_.clear();
+        key_modifier_ = 0.0;
+        goal_ = goal;
+        rhs_[goal_] = 0.0;
+        update_vertex(goal_);
+    }
+
+    DStarLitePlanner::Key DStarLitePlanner::calculate_key(graph::NodeId u) const {
+        double best = std::min(g_[u], rhs_[u]);
+        return {best + heuristic_(search_graph_.points[start_], search_graph_.points[u]) + key_modifier_, best};
+    }
+
+    double DStarLitePlanner::best_successor_cost(graph::NodeId u) const {
+        double best = INF;
+        for (const auto& edge : graph_.adj[u]) {
+            best = std::min(best, edge.weight + g_[edge.to]);
+        }
+        return best;
+    }
+
+    void DStarLitePlanner::update_vertex(graph::NodeId u) {
+        if (g_[u] != rhs_[u]) {
+            // No decrease-key: push again, outdated entries are skipped on pop
+            queued_key_[u] = calculate_key(u);
+            queued_[u] = 1;
+            open_.push(queued_key_[u], u);
+        } else {
+            queued_[u] = 0;
+        }
+    }
+
+    void DStarLitePlanner::compute_shortest_path() {
+        PF_SCOPED_TIMER("dstar.search");
+        while (!open_.empty()) {
+            auto [key, u] = open_.top();
+            if (!queued_[u] || key != queued_key_[u]) {
+                open_.pop();
+                continue;
+            }
+            const Key start_key = calculate_key(start_);
+            if (key.first > start_key.first + KEY_TOLERANCE * (1.0 + std::abs(start_key.first)) &&
+                rhs_[start_] <= g_[start_]) {
+                break;
+            }
+            open_.pop();
+            queued_[u] = 0;
+
+            Key new_key = calculate_key(u);
+            if (key < new_key) {
+                update_vertex(u);
+                continue;
+            }
+
+            ++expanded_;
+            PF_COUNT(nodes_expanded, 1);
+            if (g_[u] > rhs_[u]) {
+                g_[u] = rhs_[u];
+                for (const auto& edge : graph_.adj[u]) {
+                    auto s = static_cast<graph::NodeId>(edge.to);
+                    if (s != goal_ && edge.weight + g_[u] < rhs_[s]) {
+                        rhs_[s] = edge.weight + g_[u];
+                        PF_COUNT(edges_relaxed, 1);
+                    }
+                    update_vertex(s);
+                }
+            } else {
+                const double old_g = g_[u];
+                g_[u] = INF;
+                for (const auto& edge : graph_.adj[u]) {
+                    auto s = static_cast<graph::NodeId>(edge.to);
+                    if (s != goal_ && rhs_[s] == edge.weight + old_g) {
+                        rhs_[s] = best_successor_cost(s);
+                    }
+                    update_vertex(s);
+                }
+                if (u != goal_) {
+                    rhs_[u] = best_successor_cost(u);
+                }
+                update_vertex(u);
+            }
+        }
+    }
+
+    DStarLitePlanner::Descent DStarLitePlanner::extract_path(std::vector<graph::NodeId>& nodes) const {
+        // The search may stop with the start itself still queued, so its rhs,
+        // not its g, tells whether a path exists
+        if (rhs_[start_] == INF) {
+            return Descent::NoPath;
+        }
+
+        // Greedy descent of g from the start. g is exact on consistent nodes,
+        // so every node stepped on must be consistent.
+        nodes.push_back(start_);
+        graph::NodeId u = start_;
+        while (u != goal_) {
+            graph::NodeId next = graph::INVALID_NODE;
+            double best = INF;
+            for (const auto& edge : graph_.adj[u]) {
+                double cost = edge.weight + g_[edge.to];
+                if (cost < best) {
+                    best = cost;
+                    next = static_cast<graph::NodeId>(edge.to);
+                }
+            }
+            if (next == graph::INVALID_NODE || g_[next] != rhs_[next] || nodes.size() > graph_.adj.size()) {
+                return Descent::Stale;
+            }
+            nodes.push_back(next);
+            u = next;
+        }
+        return Descent::Found;
+    }
+
+} // namespace algorithms
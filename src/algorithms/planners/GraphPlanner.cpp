@@ -0,0 +1,87 @@
+//
+// Implementation of GraphPlanner
+//
+
+#include "../../include/algorithms/GraphPlanner.h"
+#include "../../include/algorithms/GridGraphBuilder.h"
+#include "../../include/algorithms/GraphCache.h"
+#include <stdexcept>
+
+namespace algorithms {
+
+    GraphPlanner::GraphPlanner(std::shared_ptr<graph::GraphBuilder> builder, NodeLocator locator)
+        : builder_(std::move(builder)), locator_(std::move(locator)) {
+        if (!builder_) {
+            throw std::invalid_argument("Graph builder must not be null");
+        }
+        if (!locator_.node_point || !locator_.node_id) {
+            throw std::invalid_argument("Node locator must provide node_point and node_id");
+        }
+    }
+
+    const SearchGraph& GraphPlanner::prepare(const geometry::Scene& scene) {
+        PF_SCOPED_TIMER("graph.build");
+
+        // Grid graphs can be emitted in CSR form directly, and restored from the cache
+        auto grid_builder = std::dynamic_pointer_cast<graph::GridGraphBuilder>(builder_);
+        std::uint64_t cache_key = 0;
+        if (grid_builder && graph_cache_) {
+            cache_key = GraphCache::key(scene, *grid_builder);
+            if (auto cached = graph_cache_->load(cache_key)) {
+                try {
+                    grid_builder->restore(scene, cached->graph, cached->points);
+                    search_graph_ = std::move(*cached);
+                    return search_graph_;
+                } catch (const std::invalid_argument&) {
+                    // Well-formed file but not a graph of this grid: a miss,
+                    // rebuilt and stored over below
+                }
+            }
+        }
+
+        if (grid_builder) {
+            search_graph_.graph = grid_builder->build_csr(scene);
+        } else {
+            search_graph_.graph = graph::CsrGraph::from_adjacency(builder_->build(scene));
+        }
+
+        const std::size_t node_count = search_graph_.graph.node_count();
+        search_graph_.points.resize(node_count);
+        for (std::size_t i = 0; i < node_count; ++i) {
+            search_graph_.points[i] = locator_.node_point(i);
+        }
+
+        if (grid_builder && graph_cache_) {
+            graph_cache_->store(cache_key, search_graph_);
+        }
+        return search_graph_;
+    }
+
+    std::optional<graph::NodeId> GraphPlanner::locate(const geometry::Point& point) const {
+        auto node = locator_.node_id(point);
+        if (!node || *node >= search_graph_.points.size()) {
+            return std::nullopt;
+        }
+        return static_cast<graph::NodeId>(*node);
+    }
+
+    geometry::Path GraphPlanner::make_path(const geometry::Point& start, const geometry::Point& goal,
+                                           const std::vector<graph::NodeId>& nodes) const {
+        geometry::Path path;
+        path.points.reserve(nodes.size() + 2);
+        path.points.push_back(start);
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            if (i > 0) {
+                builder_->append_edge_path(nodes[i - 1], nodes[i], path.points);
+            }
+            if (!(search_graph_.points[nodes[i]] == path.points.back())) {
+                path.points.push_back(search_graph_.points[nodes[i]]);
+            }
+        }
+        if (!(goal == path.points.back())) {
+            path.points.push_back(goal);
+        }
+        return path;
+    }
+
+} // namespace algorithms
@@ -0,0 +1,820 @@
+//
+// Implementation of HpaStarPlanner
+//
+
+#include "../../include/algorithms/HpaStarPlanner.h"
+#include "../../include/algorithms/Heuristics.h"
+#include "../../include/geometry/ObstacleDelta.h"
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace algorithms {
+
+    namespace {
+
+        constexpr double INF = std::numeric_limits<double>::infinity();
+
+        // Runs of free crossings at least this long get a transition at each
+        // end and about every TRANSITION_SPACING crossings between them,
+        // shorter ones a single one in the middle
+        constexpr int SPLIT_RUN_LENGTH = 6;
+        constexpr int TRANSITION_SPACING = 16;
+
+        // Queries whose clusters are at most this many clusters apart are
+        // first searched directly on the grid, in the box of both clusters
+        constexpr int LOCAL_CLUSTER_RANGE = 2;
+
+        // GridOccupancy directions come in opposite pairs d and d ^ 2
+        constexpr std::uint8_t opposite(std::uint8_t dir) {
+            return static_cast<std::uint8_t>(dir ^ 2);
+        }
+
+        std::uint8_t direction_between(int from_x, int from_y, int to_x, int to_y) {
+            for (std::uint8_t dir = 0; dir < 8; ++dir) {
+                if (from_x + graph::GridOccupancy::dx[dir] == to_x && from_y + graph::GridOccupancy::dy[dir] == to_y) {
+                    return dir;
+                }
+            }
+            throw std::logic_error("Cells are not neighbours");
+        }
+
+    }
+
+    HpaStarPlanner::HpaStarPlanner(std::shared_ptr<graph::GridGraphBuilder> builder, int cluster_size)
+        : builder_(std::move(builder)), cluster_size_(cluster_size) {
+        if (!builder_) {
+            throw std::invalid_argument("Grid graph builder must not be null");
+        }
+        if (cluster_size_ < 2) {
+            throw std::invalid_argument("Cluster size must be at least 2 cells");
+        }
+    }
+
+    std::string HpaStarPlanner::name() const {
+        return "HPA*";
+    }
+
+    void HpaStarPlanner::reset() {
+        has_abstraction_ = false;
+        occupancy_ = {};
+        obstacles_.clear();
+        clusters_.clear();
+        abstract_.clear();
+        node_base_.clear();
+        node_cluster_.clear();
+        node_points_.clear();
+    }
+
+    PathResult HpaStarPlanner::find_path(const geometry::Scene& scene) {
+        prepare(scene);
+        return find_prepared_path(scene.start, scene.goal);
+    }
+
+    BatchResult HpaStarPlanner::plan_batch(const geometry::Scene& scene, std::span<const Query> queries) {
+        BatchResult batch;
+        batch.results.reserve(queries.size());
+
+        // Building the abstraction reports into the batch, each query into its own result
+        instrumentation::ProfileScope profile_scope(batch.profile);
+        auto batch_start = std::chrono::steady_clock::now();
+        prepare(scene);
+
+        const std::string algorithm_name = name();
+        for (const auto& query : queries) {
+            BenchmarkResult& result = batch.results.emplace_back();
+            result.algorithm_name = algorithm_name;
+            instrumentation::ProfileScope query_scope(result.profile);
+
+            auto start_time = std::chrono::steady_clock::now();
+            PathResult path = find_prepared_path(query.start, query.goal);
+            auto end_time = std::chrono::steady_clock::now();
+
+            result.runtime_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+            if (path) {
+                result.path = std::move(*path);
+            }
+        }
+        auto batch_end = std::chrono::steady_clock::now();
+
+        batch.total_ms = std::chrono::duration<double, std::milli>(batch_end - batch_start).count();
+        if (batch.total_ms > 0.0) {
+            batch.queries_per_second = static_cast<double>(queries.size()) * 1000.0 / batch.total_ms;
+        }
+        return batch;
+    }
+
+    void HpaStarPlanner::prepare(const geometry::Scene& scene) {
+        PF_SCOPED_TIMER("hpa.abstraction");
+        rebuilt_clusters_ = 0;
+
+        const bool same_grid = has_abstraction_ && step_ == builder_->get_grid_step() &&
+                               diagonal_ == builder_->is_diagonal_allowed() &&
+                               scene_width_ == scene.width && scene_height_ == scene.height;
+        std::vector<std::uint8_t> dirty;
+        if (same_grid) {
+            auto deltas = geometry::diff_obstacles(obstacles_, scene.obstacles);
+            if (!deltas.empty()) {
+                dirty.assign(clusters_.size(), 0);
+                for (const auto& window : builder_->update_occupancy(scene, deltas, occupancy_)) {
+                    // Edges of cells one step outside the window may have changed too
+                    int cx0 = std::max(window.x0 - 1, 0) / cluster_size_;
+                    int cy0 = std::max(window.y0 - 1, 0) / cluster_size_;
+                    int cx1 = std::min(window.x1 + 1, occupancy_.width() - 1) / cluster_size_;
+                    int cy1 = std::min(window.y1 + 1, occupancy_.height() - 1) / cluster_size_;
+                    for (int cy = cy0; cy <= cy1; ++cy) {
+                        for (int cx = cx0; cx <= cx1; ++cx) {
+                            dirty[cy * clusters_x_ + cx] = 1;
+                        }
+                    }
+                }
+            }
+        } else {
+            occupancy_ = builder_->build_occupancy(scene);
+            if (occupancy_.cell_count() >= graph::INVALID_NODE) {
+                throw std::length_error("Grid has too many cells for 32-bit cell ids");
+            }
+            step_ = builder_->get_grid_step();
+            diagonal_ = builder_->is_diagonal_allowed();
+            scene_width_ = scene.width;
+            scene_height_ = scene.height;
+            clusters_x_ = (occupancy_.width() + cluster_size_ - 1) / cluster_size_;
+            clusters_y_ = (occupancy_.height() + cluster_size_ - 1) / cluster_size_;
+            clusters_.assign(static_cast<std::size_t>(clusters_x_) * clusters_y_, {});
+            dirty.assign(clusters_.size(), 1);
+            has_abstraction_ = true;
+        }
+        obstacles_ = scene.obstacles;
+
+        if (std::find(dirty.begin(), dirty.end(), 1) != dirty.end()) {
+            rebuild(dirty);
+        }
+    }
+
+    void HpaStarPlanner::rebuild(const std::vector<std::uint8_t>& dirty) {
+        const std::size_t count = clusters_.size();
+
+        // Calls fn(n) for every cluster n at offset (ox, oy) from c, ox and oy in -1..1
+        auto for_each_around = [this](std::size_t c, std::initializer_list<std::pair<int, int>> offsets, auto&& fn) {
+            const int cx = static_cast<int>(c % clusters_x_);
+            const int cy = static_cast<int>(c / clusters_x_);
+            for (auto [ox, oy] : offsets) {
+                if (cx + ox >= 0 && cx + ox < clusters_x_ && cy + oy >= 0 && cy + oy < clusters_y_) {
+                    fn(static_cast<std::size_t>((cy + oy) * clusters_x_ + cx + ox));
+                }
+            }
+        };
+
+        // Borders touching a dirty cluster, i.e. its own and those its west and
+        // north neighbours own (diagonal crossings belong to the upper cluster),
+        // and the clusters on either side of them
+        std::vector<std::uint8_t> border(count, 0);
+        std::vector<std::uint8_t> touched(count, 0);
+        for (std::size_t c = 0; c < count; ++c) {
+            if (dirty[c]) {
+                for_each_around(c, {{0, 0}, {-1, 0}, {1, 0}, {-1, -1}, {0, -1}, {1, -1}},
+                                [&](std::size_t n) { border[n] = 1; });
+            }
+        }
+        for (std::size_t c = 0; c < count; ++c) {
+            if (!border[c]) {
+                continue;
+            }
+            find_transitions(static_cast<int>(c));
+            for_each_around(c, {{0, 0}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}},
+                            [&](std::size_t n) { touched[n] = 1; });
+        }
+
+        // A cluster's inner paths are recomputed if its cells changed or it kept
+        // its nodes but its inside changed
+        std::vector<std::size_t> jobs;
+        std::vector<std::uint32_t> cells;
+        for (std::size_t c = 0; c < count; ++c) {
+            if (!touched[c]) {
+                continue;
+            }
+            cells.clear();
+            for (const auto* transitions : {&clusters_[c].east, &clusters_[c].south, &clusters_[c].diagonal}) {
+                for (const auto& transition : *transitions) {
+                    cells.push_back(transition.inside);
+                }
+            }
+            for_each_around(c, {{-1, 0}, {1, 0}, {-1, -1}, {0, -1}, {1, -1}}, [&](std::size_t n) {
+                for (const auto* transitions : {&clusters_[n].east, &clusters_[n].south, &clusters_[n].diagonal}) {
+                    for (const auto& transition : *transitions) {
+                        if (static_cast<std::size_t>(cluster_of(transition.outside)) == c) {
+                            cells.push_back(transition.outside);
+                        }
+                    }
+                }
+            });
+            std::sort(cells.begin(), cells.end());
+            cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+            if (dirty[c] || cells != clusters_[c].cells) {
+                clusters_[c].cells = cells;
+                jobs.push_back(c);
+            }
+        }
+
+        if (!pool_ || pool_threads_ != thread_count_) {
+            pool_ = std::make_unique<ThreadPool>(thread_count_);
+            pool_threads_ = thread_count_;
+        }
+        build_searches_.resize(pool_->size());
+        pool_->parallel_for(jobs.size(), [&](std::size_t i, unsigned worker) {
+            compute_paths(clusters_[jobs[i]], build_searches_[worker]);
+        });
+        rebuilt_clusters_ = jobs.size();
+
+        build_abstract_graph();
+        compute_landmarks();
+    }
+
+    void HpaStarPlanner::find_transitions(int cluster) {
+        Cluster& c = clusters_[cluster];
+        const graph::CellWindow window = cluster_window(cluster);
+        const int cx = cluster % clusters_x_;
+        const int cy = cluster / clusters_x_;
+
+        // Splits the crossings first..last (inclusive) along a border into runs.
+        // A run only goes on from i - 1 to i if both cells on each side are
+        // joined along the border, so every crossing reaches a transition of its run.
+        auto add_runs = [](int first, int last, auto&& is_open, auto&& is_linked, auto&& add) {
+            int run_start = -1;
+            auto close_run = [&](int run_end) {
+                const int length = run_end - run_start + 1;
+                if (length >= SPLIT_RUN_LENGTH) {
+                    const int gaps = std::max(1, (length - 1 + TRANSITION_SPACING / 2) / TRANSITION_SPACING);
+                    for (int k = 0; k <= gaps; ++k) {
+                        add(run_start + (length - 1) * k / gaps);
+                    }
+                } else {
+                    add(run_start + (run_end - run_start) / 2);
+                }
+                run_start = -1;
+            };
+            for (int i = first; i <= last; ++i) {
+                if (!is_open(i)) {
+                    if (run_start >= 0) {
+                        close_run(i - 1);
+                    }
+                    continue;
+                }
+                if (run_start >= 0 && !is_linked(i)) {
+                    close_run(i - 1);
+                }
+                if (run_start < 0) {
+                    run_start = i;
+                }
+            }
+            if (run_start >= 0) {
+                close_run(last);
+            }
+        };
+
+        c.east.clear();
+        if (cx + 1 < clusters_x_) {
+            const int x = window.x1;
+            add_runs(window.y0, window.y1,
+                     [&](int y) { return occupancy_.is_edge_free(x, y, 1); },
+                     [&](int y) { return occupancy_.is_edge_free(x, y, 0) && occupancy_.is_edge_free(x + 1, y, 0); },
+                     [&](int y) {
+                         c.east.push_back({static_cast<std::uint32_t>(occupancy_.index(x, y)),
+                                           static_cast<std::uint32_t>(occupancy_.index(x + 1, y))});
+                     });
+        }
+        c.south.clear();
+        if (cy + 1 < clusters_y_) {
+            const int y = window.y1;
+            add_runs(window.x0, window.x1,
+                     [&](int x) { return occupancy_.is_edge_free(x, y, 2); },
+                     [&](int x) { return occupancy_.is_edge_free(x, y, 3) && occupancy_.is_edge_free(x, y + 1, 3); },
+                     [&](int x) {
+                         c.south.push_back({static_cast<std::uint32_t>(occupancy_.index(x, y)),
+                                            static_cast<std::uint32_t>(occupancy_.index(x, y + 1))});
+                     });
+        }
+
+        // Diagonal moves down and out of the cluster (across the east, south or
+        // west border, or the SE or SW corner). Those with a free detour of two
+        // orthogonal moves are covered by the runs; the rest are the only way
+        // across and each becomes a transition.
+        c.diagonal.clear();
+        if (!diagonal_) {
+            return;
+        }
+        auto add_diagonal = [&](int x, int y, int dir) {
+            const int nx = x + graph::GridOccupancy::dx[dir];
+            const int ny = y + graph::GridOccupancy::dy[dir];
+            if (!occupancy_.is_edge_free(x, y, dir)) {
+                return;
+            }
+            const int horizontal = nx > x ? 1 : 3;
+            if ((occupancy_.is_edge_free(x, y, horizontal) && occupancy_.is_edge_free(nx, y, 2)) ||
+                (occupancy_.is_edge_free(x, y, 2) && occupancy_.is_edge_free(x, ny, horizontal))) {
+                return;
+            }
+            c.diagonal.push_back({static_cast<std::uint32_t>(occupancy_.index(x, y)),
+                                  static_cast<std::uint32_t>(occupancy_.index(nx, ny))});
+        };
+        for (int y = window.y0; y < window.y1; ++y) {
+            add_diagonal(window.x1, y, 6);
+            add_diagonal(window.x0, y, 7);
+        }
+        for (int x = window.x0; x <= window.x1; ++x) {
+            add_diagonal(x, window.y1, 6);
+            add_diagonal(x, window.y1, 7);
+        }
+    }
+
+    void HpaStarPlanner::compute_paths(Cluster& cluster, LocalSearch& search) const {
+        const std::size_t n = cluster.cells.size();
+        cluster.distances.assign(n * n, INF);
+        cluster.path_offsets.assign(n * n + 1, 0);
+        cluster.moves.clear();
+
+        // One search per node covers the pairs with every later node; the
+        // graph is symmetric, so the other half mirrors them
+        for (std::size_t i = 0; i < n; ++i) {
+            cluster.distances[i * n + i] = 0.0;
+            auto later = std::span<const std::uint32_t>(cluster.cells).subspan(i + 1);
+            if (!later.empty()) {
+                local_search(search, cluster.cells[i], cluster_window(cluster_of(cluster.cells[i])), later);
+            }
+            for (std::size_t j = 0; j < n; ++j) {
+                cluster.path_offsets[i * n + j] = static_cast<std::uint32_t>(cluster.moves.size());
+                if (j <= i) {
+                    continue;
+                }
+                double distance = local_distance(search, cluster.cells[j]);
+                if (distance == INF) {
+                    continue;
+                }
+                cluster.distances[i * n + j] = distance;
+                cluster.distances[j * n + i] = distance;
+                append_local_moves(search, cluster.cells[j], cluster.moves);
+            }
+        }
+        cluster.path_offsets[n * n] = static_cast<std::uint32_t>(cluster.moves.size());
+    }
+
+    void HpaStarPlanner::build_abstract_graph() {
+        const std::size_t count = clusters_.size();
+        node_base_.assign(count + 1, 0);
+        for (std::size_t c = 0; c < count; ++c) {
+            node_base_[c + 1] = node_base_[c] + static_cast<std::uint32_t>(clusters_[c].cells.size());
+        }
+        const std::size_t node_count = node_base_[count];
+        if (node_count + 2 >= graph::INVALID_NODE) {
+            throw std::length_error("Too many abstract nodes for 32-bit node ids");
+        }
+        node_cluster_.resize(node_count);
+        node_points_.resize(node_count);
+
+        auto node_of = [this](std::size_t c, std::uint32_t cell) {
+            const auto& cells = clusters_[c].cells;
+            auto it = std::lower_bound(cells.begin(), cells.end(), cell);
+            return node_base_[c] + static_cast<std::uint32_t>(it - cells.begin());
+        };
+
+        const double diagonal_step = step_ * std::sqrt(2.0);
+        graph::Graph adjacency;
+        adjacency.adj.resize(node_count);
+        for (std::size_t c = 0; c < count; ++c) {
+            const Cluster& cluster = clusters_[c];
+            const std::size_t n = cluster.cells.size();
+            const std::uint32_t base = node_base_[c];
+            for (std::size_t i = 0; i < n; ++i) {
+                node_cluster_[base + i] = static_cast<std::uint32_t>(c);
+                node_points_[base + i] = cell_point(cluster.cells[i]);
+                for (std::size_t j = 0; j < n; ++j) {
+                    if (i != j && cluster.distances[i * n + j] != INF) {
+                        adjacency.adj[base + i].push_back({base + j, cluster.distances[i * n + j]});
+                    }
+                }
+            }
+
+            // Crossings are single moves
+            for (const auto& transition : cluster.east) {
+                std::uint32_t u = node_of(c, transition.inside);
+                std::uint32_t v = node_of(c + 1, transition.outside);
+                adjacency.adj[u].push_back({v, step_});
+                adjacency.adj[v].push_back({u, step_});
+            }
+            for (const auto& transition : cluster.south) {
+                std::uint32_t u = node_of(c, transition.inside);
+                std::uint32_t v = node_of(c + clusters_x_, transition.outside);
+                adjacency.adj[u].push_back({v, step_});
+                adjacency.adj[v].push_back({u, step_});
+            }
+            for (const auto& transition : cluster.diagonal) {
+                std::uint32_t u = node_of(c, transition.inside);
+                std::uint32_t v = node_of(static_cast<std::size_t>(cluster_of(transition.outside)), transition.outside);
+                adjacency.adj[u].push_back({v, diagonal_step});
+                adjacency.adj[v].push_back({u, diagonal_step});
+            }
+        }
+        abstract_ = graph::CsrGraph::from_adjacency(adjacency);
+    }
+
+    void HpaStarPlanner::compute_landmarks() {
+        PF_SCOPED_TIMER("hpa.landmarks");
+        const std::size_t node_count = abstract_.node_count();
+        std::vector<graph::NodeId> landmarks;
+        if (node_count > 0) {
+            // Nodes nearest to the corners and edge midpoints of the grid
+            const double width = occupancy_.width() * step_;
+            const double height = occupancy_.height() * step_;
+            const geometry::Point anchors[] = {
+                {0.0, 0.0}, {width / 2, 0.0}, {width, 0.0}, {width, height / 2},
+                {width, height}, {width / 2, height}, {0.0, height}, {0.0, height / 2}
+            };
+            for (const auto& anchor : anchors) {
+                graph::NodeId nearest = 0;
+                for (graph::NodeId v = 1; v < node_count; ++v) {
+                    if (node_points_[v].distance(anchor) < node_points_[nearest].distance(anchor)) {
+                        nearest = v;
+                    }
+                }
+                if (std::find(landmarks.begin(), landmarks.end(), nearest) == landmarks.end()) {
+                    landmarks.push_back(nearest);
+                }
+            }
+        }
+        landmark_count_ = landmarks.size();
+        landmark_distances_.assign(node_count * landmark_count_, INF);
+
+        // Dijkstra from every landmark; the graph is symmetric, so these are
+        // the distances to the landmarks as well
+        pool_->parallel_for(landmark_count_, [&](std::size_t l, unsigned) {
+            DaryHeap<double> open;
+            std::vector<std::uint8_t> settled(node_count, 0);
+            landmark_distances_[landmarks[l] * landmark_count_ + l] = 0.0;
+            open.push(0.0, landmarks[l]);
+            while (!open.empty()) {
+                const double g_u = open.top().key;
+                graph::NodeId u = open.top().node;
+                open.pop();
+                if (settled[u]) {
+                    continue;
+                }
+                settled[u] = 1;
+                abstract_.for_each_neighbor(u, [&](graph::NodeId v, double weight) {
+                    double& g_v = landmark_distances_[v * landmark_count_ + l];
+                    if (g_u + weight < g_v) {
+                        g_v = g_u + weight;
+                        open.push(g_v, v);
+                    }
+                });
+            }
+        });
+    }
+
+    PathResult HpaStarPlanner::find_prepared_path(const geometry::Point& start, const geometry::Point& goal) {
+        const int width = occupancy_.width();
+        const int height = occupancy_.height();
+        auto is_free = [this](int gx, int gy) { return occupancy_.is_cell_free(gx, gy); };
+        auto start_cell = graph::find_nearest_cell(width, height, step_, start, builder_->get_snap_radius(), is_free);
+        auto goal_cell = graph::find_nearest_cell(width, height, step_, goal, builder_->get_snap_radius(), is_free);
+        if (!start_cell || !goal_cell) {
+            return std::nullopt;
+        }
+        const auto start_index = static_cast<std::uint32_t>(occupancy_.index(start_cell->first, start_cell->second));
+        const auto goal_index = static_cast<std::uint32_t>(occupancy_.index(goal_cell->first, goal_cell->second));
+
+        // Moves from the start cell to the goal cell
+        std::vector<std::uint8_t> moves;
+        {
+            PF_SCOPED_TIMER("hpa.search");
+            expanded_ = 0;
+
+            // Start and goal in nearby clusters: the best path inside the box of
+            // both clusters is an upper bound, and the abstract search only runs
+            // to find a shorter one around it. This avoids the detours through
+            // transitions that dominate short paths.
+            double bound = INF;
+            const int start_cluster = cluster_of(start_index);
+            const int goal_cluster = cluster_of(goal_index);
+            if (std::abs(start_cluster % clusters_x_ - goal_cluster % clusters_x_) <= LOCAL_CLUSTER_RANGE &&
+                std::abs(start_cluster / clusters_x_ - goal_cluster / clusters_x_) <= LOCAL_CLUSTER_RANGE) {
+                const graph::CellWindow start_window = cluster_window(start_cluster);
+                const graph::CellWindow goal_window = cluster_window(goal_cluster);
+                const graph::CellWindow window{std::min(start_window.x0, goal_window.x0),
+                                               std::min(start_window.y0, goal_window.y0),
+                                               std::max(start_window.x1, goal_window.x1),
+                                               std::max(start_window.y1, goal_window.y1)};
+                const std::uint32_t target[] = {goal_index};
+                local_search(start_search_, start_index, window, target);
+                bound = local_distance(start_search_, goal_index);
+                if (bound != INF) {
+                    append_local_moves(start_search_, goal_index, moves);
+                }
+            }
+            if (search(start_index, goal_index, bound)) {
+                moves.clear();
+                std::vector<graph::NodeId> nodes;
+                const auto goal_node = static_cast<graph::NodeId>(abstract_.node_count() + 1);
+                for (graph::NodeId u = parent_[goal_node]; u != static_cast<graph::NodeId>(abstract_.node_count());
+                     u = parent_[u]) {
+                    nodes.push_back(u);
+                }
+                std::reverse(nodes.begin(), nodes.end());
+
+                auto node_cell = [this](graph::NodeId node) {
+                    const std::uint32_t c = node_cluster_[node];
+                    return clusters_[c].cells[node - node_base_[c]];
+                };
+                append_local_moves(start_search_, node_cell(nodes.front()), moves);
+                for (std::size_t k = 1; k < nodes.size(); ++k) {
+                    const std::uint32_t c = node_cluster_[nodes[k - 1]];
+                    if (node_cluster_[nodes[k]] != c) {
+                        const std::uint32_t from_cell = node_cell(nodes[k - 1]);
+                        const std::uint32_t to_cell = node_cell(nodes[k]);
+                        moves.push_back(direction_between(static_cast<int>(from_cell % width),
+                                                          static_cast<int>(from_cell / width),
+                                                          static_cast<int>(to_cell % width),
+                                                          static_cast<int>(to_cell / width)));
+                        continue;
+                    }
+                    const Cluster& from_cluster = clusters_[c];
+                    const std::size_t n = from_cluster.cells.size();
+                    const std::size_t i = nodes[k - 1] - node_base_[c];
+                    const std::size_t j = nodes[k] - node_base_[c];
+                    const std::size_t pair = std::min(i, j) * n + std::max(i, j);
+                    auto first = from_cluster.moves.begin() + from_cluster.path_offsets[pair];
+                    auto last = from_cluster.moves.begin() + from_cluster.path_offsets[pair + 1];
+                    if (i < j) {
+                        moves.insert(moves.end(), first, last);
+                    } else {
+                        for (auto it = last; it != first; --it) {
+                            moves.push_back(opposite(*(it - 1)));
+                        }
+                    }
+                }
+
+                // The goal side was searched from the goal, so its moves run backwards
+                const std::size_t goal_side = moves.size();
+                append_local_moves(goal_search_, node_cell(nodes.back()), moves);
+                std::reverse(moves.begin() + static_cast<std::ptrdiff_t>(goal_side), moves.end());
+                for (std::size_t k = goal_side; k < moves.size(); ++k) {
+                    moves[k] = opposite(moves[k]);
+                }
+            } else if (bound == INF) {
+                return std::nullopt;
+            }
+        }
+
+        // Cell centers where the moves turn
+        geometry::Path path;
+        path.points.push_back(start);
+        int x = start_cell->first;
+        int y = start_cell->second;
+        auto push = [&path](const geometry::Point& point) {
+            if (!(point == path.points.back())) {
+                path.points.push_back(point);
+            }
+        };
+        push(cell_point(start_index));
+        for (std::size_t k = 0; k < moves.size(); ++k) {
+            x += graph::GridOccupancy::dx[moves[k]];
+            y += graph::GridOccupancy::dy[moves[k]];
+            if (k + 1 == moves.size() || moves[k + 1] != moves[k]) {
+                push(cell_point(static_cast<std::uint32_t>(occupancy_.index(x, y))));
+            }
+        }
+        push(goal);
+        return path;
+    }
+
+    bool HpaStarPlanner::search(std::uint32_t start_cell, std::uint32_t goal_cell, double bound) {
+        const std::size_t node_count = abstract_.node_count();
+        const auto start_node = static_cast<graph::NodeId>(node_count);
+        const auto goal_node = static_cast<graph::NodeId>(node_count + 1);
+        if (g_.size() < node_count + 2) {
+            PF_COUNT(bytes_allocated, (node_count + 2 - g_.size()) *
+                     (sizeof(double) + sizeof(graph::NodeId) + 2 * sizeof(std::uint32_t)));
+            g_.resize(node_count + 2);
+            parent_.resize(node_count + 2);
+            seen_.resize(node_count + 2, 0);
+            closed_.resize(node_count + 2, 0);
+        }
+        if (++generation_ == 0) {
+            std::fill(seen_.begin(), seen_.end(), 0);
+            std::fill(closed_.begin(), closed_.end(), 0);
+            generation_ = 1;
+        }
+
+        // Start and goal join the nodes of their clusters they reach inside them
+        const int start_cluster = cluster_of(start_cell);
+        const int goal_cluster = cluster_of(goal_cell);
+        local_search(start_search_, start_cell, cluster_window(start_cluster), clusters_[start_cluster].cells);
+        local_search(goal_search_, goal_cell, cluster_window(goal_cluster), clusters_[goal_cluster].cells);
+
+        // Landmark distances of the goal, reached through the nodes of its cluster
+        const std::size_t landmark_count = landmark_count_;
+        goal_landmarks_.assign(landmark_count, INF);
+        const auto& goal_cells = clusters_[goal_cluster].cells;
+        for (std::size_t i = 0; i < goal_cells.size(); ++i) {
+            double distance = local_distance(goal_search_, goal_cells[i]);
+            if (distance == INF) {
+                continue;
+            }
+            const double* through = landmark_distances_.data() + (node_base_[goal_cluster] + i) * landmark_count;
+            for (std::size_t l = 0; l < landmark_count; ++l) {
+                goal_landmarks_[l] = std::min(goal_landmarks_[l], through[l] + distance);
+            }
+        }
+
+        OctileHeuristic octile;
+        const geometry::Point goal_point = cell_point(goal_cell);
+        auto estimate = [&](graph::NodeId v) {
+            double h = octile(node_points_[v], goal_point);
+            const double* to_landmark = landmark_distances_.data() + v * landmark_count;
+            for (std::size_t l = 0; l < landmark_count; ++l) {
+                if (to_landmark[l] != INF && goal_landmarks_[l] != INF) {
+                    h = std::max(h, std::abs(goal_landmarks_[l] - to_landmark[l]));
+                }
+            }
+            return h;
+        };
+        auto relax = [&](graph::NodeId v, double g_v, graph::NodeId u) {
+            if (closed_[v] == generation_ || (seen_[v] == generation_ && g_v >= g_[v])) {
+                return;
+            }
+            seen_[v] = generation_;
+            g_[v] = g_v;
+            parent_[v] = u;
+            PF_COUNT(edges_relaxed, 1);
+            open_.push(g_v + (v == goal_node ? 0.0 : estimate(v)), v);
+        };
+
+        open_.clear();
+        seen_[start_node] = generation_;
+        g_[start_node] = 0.0;
+        parent_[start_node] = graph::INVALID_NODE;
+        open_.push(octile(cell_point(start_cell), goal_point), start_node);
+
+        while (!open_.empty() && open_.top().key < bound) {
+            graph::NodeId u = open_.top().node;
+            open_.pop();
+            if (closed_[u] == generation_) {
+                continue; // outdated entry
+            }
+            closed_[u] = generation_;
+            ++expanded_;
+            PF_COUNT(nodes_expanded, 1);
+
+            if (u == goal_node) {
+                return true;
+            }
+            if (u == start_node) {
+                const auto& cells = clusters_[start_cluster].cells;
+                for (std::size_t i = 0; i < cells.size(); ++i) {
+                    double distance = local_distance(start_search_, cells[i]);
+                    if (distance != INF) {
+                        graph::NodeId v = node_base_[start_cluster] + static_cast<graph::NodeId>(i);
+                        relax(v, distance, u);
+                    }
+                }
+                continue;
+            }
+
+            const double g_u = g_[u];
+            abstract_.for_each_neighbor(u, [&](graph::NodeId v, double weight) {
+                relax(v, g_u + weight, u);
+            });
+            if (node_cluster_[u] == static_cast<std::uint32_t>(goal_cluster)) {
+                double distance = local_distance(goal_search_, clusters_[goal_cluster].cells[u - node_base_[goal_cluster]]);
+                if (distance != INF) {
+                    relax(goal_node, g_u + distance, u);
+                }
+            }
+        }
+        return false;
+    }
+
+    void HpaStarPlanner::local_search(LocalSearch& search, std::uint32_t source, const graph::CellWindow& window,
+                                      std::span<const std::uint32_t> targets) const {
+        const int width = occupancy_.width();
+        search.window = window;
+        search.source = source;
+        const int local_width = window.x1 - window.x0 + 1;
+        const auto local_size = static_cast<std::size_t>(local_width) * (window.y1 - window.y0 + 1);
+        if (search.g.size() < local_size) {
+            search.g.resize(local_size);
+            search.move.resize(local_size);
+            search.seen.resize(local_size, 0);
+            search.closed.resize(local_size, 0);
+        }
+        if (++search.generation == 0) {
+            std::fill(search.seen.begin(), search.seen.end(), 0);
+            std::fill(search.closed.begin(), search.closed.end(), 0);
+            search.generation = 1;
+        }
+        const std::uint32_t generation = search.generation;
+        auto local_index = [&](int gx, int gy) {
+            return static_cast<graph::NodeId>((gy - window.y0) * local_width + (gx - window.x0));
+        };
+
+        const int num_directions = diagonal_ ? 8 : 4;
+        const double diagonal_step = step_ * std::sqrt(2.0);
+        std::size_t remaining = targets.size();
+
+        const int source_x = static_cast<int>(source % width);
+        const int source_y = static_cast<int>(source / width);
+        const graph::NodeId source_local = local_index(source_x, source_y);
+        search.open.clear();
+        search.seen[source_local] = generation;
+        search.g[source_local] = 0.0;
+        search.open.push(0.0, source_local);
+
+        while (!search.open.empty() && remaining > 0) {
+            graph::NodeId u = search.open.top().node;
+            search.open.pop();
+            if (search.closed[u] == generation) {
+                continue; // outdated entry
+            }
+            search.closed[u] = generation;
+            PF_COUNT(nodes_expanded, 1);
+
+            const int x = window.x0 + static_cast<int>(u % local_width);
+            const int y = window.y0 + static_cast<int>(u / local_width);
+            if (std::binary_search(targets.begin(), targets.end(), static_cast<std::uint32_t>(occupancy_.index(x, y)))) {
+                --remaining;
+            }
+
+            const double g_u = search.g[u];
+            for (int dir = 0; dir < num_directions; ++dir) {
+                const int nx = x + graph::GridOccupancy::dx[dir];
+                const int ny = y + graph::GridOccupancy::dy[dir];
+                if (nx < window.x0 || nx > window.x1 || ny < window.y0 || ny > window.y1 ||
+                    !occupancy_.is_edge_free(x, y, dir)) {
+                    continue;
+                }
+                const graph::NodeId v = local_index(nx, ny);
+                const double g_v = g_u + (dir < 4 ? step_ : diagonal_step);
+                if (search.closed[v] == generation || (search.seen[v] == generation && g_v >= search.g[v])) {
+                    continue;
+                }
+                search.seen[v] = generation;
+                search.g[v] = g_v;
+                search.move[v] = static_cast<std::uint8_t>(dir);
+                search.open.push(g_v, v);
+            }
+        }
+    }
+
+    double HpaStarPlanner::local_distance(const LocalSearch& search, std::uint32_t cell) const {
+        const int width = occupancy_.width();
+        const graph::CellWindow& window = search.window;
+        const int x = static_cast<int>(cell % width);
+        const int y = static_cast<int>(cell / width);
+        if (x < window.x0 || x > window.x1 || y < window.y0 || y > window.y1) {
+            return INF;
+        }
+        const std::size_t local = static_cast<std::size_t>(y - window.y0) * (window.x1 - window.x0 + 1) + (x - window.x0);
+        return search.closed[local] == search.generation ? search.g[local] : INF;
+    }
+
+    void HpaStarPlanner::append_local_moves(const LocalSearch& search, std::uint32_t cell,
+                                            std::vector<std::uint8_t>& moves) const {
+        const int width = occupancy_.width();
+        const graph::CellWindow& window = search.window;
+        const int local_width = window.x1 - window.x0 + 1;
+        const std::size_t first = moves.size();
+        int x = static_cast<int>(cell % width);
+        int y = static_cast<int>(cell / width);
+        const int source_x = static_cast<int>(search.source % width);
+        const int source_y = static_cast<int>(search.source / width);
+        while (x != source_x || y != source_y) {
+            std::uint8_t dir = search.move[static_cast<std::size_t>(y - window.y0) * local_width + (x - window.x0)];
+            moves.push_back(dir);
+            x -= graph::GridOccupancy::dx[dir];
+            y -= graph::GridOccupancy::dy[dir];
+        }
+        std::reverse(moves.begin() + static_cast<std::ptrdiff_t>(first), moves.end());
+    }
+
+    int HpaStarPlanner::cluster_of(std::uint32_t cell) const {
+        const int width = occupancy_.width();
+        const int x = static_cast<int>(cell % width);
+        const int y = static_cast<int>(cell / width);
+        return (y / cluster_size_) * clusters_x_ + x / cluster_size_;
+    }
+
+    graph::CellWindow HpaStarPlanner::cluster_window(int cluster) const {
+        const int x0 = (cluster % clusters_x_) * cluster_size_;
+        const int y0 = (cluster / clusters_x_) * cluster_size_;
+        return {x0, y0, std::min(x0 + cluster_size_, occupancy_.width()) - 1,
+                std::min(y0 + cluster_size_, occupancy_.height()) - 1};
+    }
+
+    geometry::Point HpaStarPlanner::cell_point(std::uint32_t cell) const {
+        const auto width = static_cast<std::uint32_t>(occupancy_.width());
+        return {(static_cast<int>(cell % width) + 0.5) * step_, (static_cast<int>(cell / width) + 0.5) * step_};
+    }
+
+} // namespace algorithms
@@ -0,0 +1,272 @@
+//
+// Implementation of JpsPlanner
+//
+
+#include "../../include/algorithms/JpsPlanner.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace algorithms {
+
+    JpsPlanner::JpsPlanner(std::shared_ptr<graph::GridGraphBuilder> builder)
+        : builder_(std::move(builder)) {
+        if (!builder_) {
+            throw std::invalid_argument("Grid graph builder must not be null");
+        }
+        if (!builder_->is_diagonal_allowed()) {
+            throw std::invalid_argument("Jump Point Search requires diagonal moves");
+        }
+    }
+
+    std::string JpsPlanner::name() const {
+        return "JPS";
+    }
+
+    PathResult JpsPlanner::find_path(const geometry::Scene& scene) {
+        {
+            PF_SCOPED_TIMER("jps.cells");
+            build_cells(builder_->build_occupancy(scene));
+        }
+
+        const double step = builder_->get_grid_step();
+        auto is_walkable = [this](int gx, int gy) { return walkable(gx, gy); };
+        auto start = graph::find_nearest_cell(width_, height_, step, scene.start, builder_->get_snap_radius(), is_walkable);
+        auto goal = graph::find_nearest_cell(width_, height_, step, scene.goal, builder_->get_snap_radius(), is_walkable);
+        if (!start || !goal) {
+            return std::nullopt;
+        }
+        {
+            PF_SCOPED_TIMER("jps.search");
+            if (!search(start->first, start->second, goal->first, goal->second)) {
+                return std::nullopt;
+            }
+        }
+
+        // Jump points back to front; consecutive ones are joined by straight or
+        // diagonal runs of free edges
+        std::vector<geometry::Point> jump_points;
+        const auto goal_node = static_cast<graph::NodeId>(goal->second * width_ + goal->first);
+        for (graph::NodeId u = goal_node; u != graph::INVALID_NODE; u = parent_[u]) {
+            jump_points.push_back({(static_cast<int>(u % width_) + 0.5) * step,
+                                   (static_cast<int>(u / width_) + 0.5) * step});
+        }
+
+        geometry::Path path;
+        path.points.push_back(scene.start);
+        for (auto it = jump_points.rbegin(); it != jump_points.rend(); ++it) {
+            if (!(*it == path.points.back())) {
+                path.points.push_back(*it);
+            }
+        }
+        if (!(scene.goal == path.points.back())) {
+            path.points.push_back(scene.goal);
+        }
+        return path;
+    }
+
+    void JpsPlanner::build_cells(const graph::GridOccupancy& occupancy) {
+        width_ = occupancy.width();
+        height_ = occupancy.height();
+        stride_ = width_ + 2;
+        cells_.assign(static_cast<std::size_t>(stride_) * (height_ + 2), 0);
+        auto at = [this](int x, int y) -> std::uint16_t& {
+            return cells_[static_cast<std::size_t>(y + 1) * stride_ + (x + 1)];
+        };
+
+        // Cells whose every edge to a free neighbour is free
+        std::vector<std::uint8_t> complete(cells_.size(), 1);
+        for (int y = 0; y < height_; ++y) {
+            for (int x = 0; x < width_; ++x) {
+                if (!occupancy.is_cell_free(x, y)) {
+                    continue;
+                }
+                std::uint16_t flags = FREE;
+                for (int dir = 0; dir < 8; ++dir) {
+                    if (occupancy.is_edge_free(x, y, dir)) {
+                        flags |= 1u << dir;
+                    } else if (occupancy.is_cell_free(x + graph::GridOccupancy::dx[dir],
+                                                      y + graph::GridOccupancy::dy[dir])) {
+                        complete[static_cast<std::size_t>(y + 1) * stride_ + (x + 1)] = 0;
+                    }
+                }
+                at(x, y) = flags;
+            }
+        }
+
+        for (int y = 0; y < height_; ++y) {
+            for (int x = 0; x < width_; ++x) {
+                bool regular = true;
+                for (int ny = y; ny <= y + 2 && regular; ++ny) {
+                    for (int nx = x; nx <= x + 2 && regular; ++nx) {
+                        regular = complete[static_cast<std::size_t>(ny) * stride_ + nx] != 0;
+                    }
+                }
+                if (regular) {
+                    at(x, y) |= REGULAR;
+                }
+            }
+        }
+    }
+
+    std::optional<std::pair<int, int>> JpsPlanner::jump(int x, int y, int dx, int dy,
+                                                        int goal_x, int goal_y) const {
+        while (true) {
+            if (!can_move(x, y, dx, dy)) {
+                return std::nullopt;
+            }
+            x += dx;
+            y += dy;
+            if ((x == goal_x && y == goal_y) || !regular(x, y)) {
+                // The search expands cells next to blocked edges in every direction
+                return std::pair{x, y};
+            }
+
+            if (dx != 0 && dy != 0) {
+                // Forced neighbours: a cell behind a side obstacle is only reached through here
+                if ((!walkable(x - dx, y) && walkable(x - dx, y + dy)) ||
+                    (!walkable(x, y - dy) && walkable(x + dx, y - dy))) {
+                    return std::pair{x, y};
+                }
+                // A diagonal run stops where one of its straight sub-runs finds a jump point
+                if (jump(x, y, dx, 0, goal_x, goal_y) || jump(x, y, 0, dy, goal_x, goal_y)) {
+                    return std::pair{x, y};
+                }
+            } else if (dx != 0) {
+                if ((!walkable(x, y - 1) && walkable(x + dx, y - 1)) ||
+                    (!walkable(x, y + 1) && walkable(x + dx, y + 1))) {
+                    return std::pair{x, y};
+                }
+            } else {
+                if ((!walkable(x - 1, y) && walkable(x - 1, y + dy)) ||
+                    (!walkable(x + 1, y) && walkable(x + 1, y + dy))) {
+                    return std::pair{x, y};
+                }
+            }
+        }
+    }
+
+    bool JpsPlanner::search(int start_x, int start_y, int goal_x, int goal_y) {
+        begin_query();
+        expanded_ = 0;
+
+        const double step = builder_->get_grid_step();
+        auto node_of = [this](int x, int y) { return static_cast<graph::NodeId>(y * width_ + x); };
+        auto octile = [step](int ax, int ay, int bx, int by) {
+            int dx = std::abs(ax - bx);
+            int dy = std::abs(ay - by);
+            return step * (std::max(dx, dy) + (std::sqrt(2.0) - 1.0) * std::min(dx, dy));
+        };
+
+        const graph::NodeId start = node_of(start_x, start_y);
+        const graph::NodeId goal = node_of(goal_x, goal_y);
+        seen_[start] = generation_;
+        g_[start] = 0.0;
+        parent_[start] = graph::INVALID_NODE;
+        open_.push(octile(start_x, start_y, goal_x, goal_y), start);
+
+        int directions[8][2];
+        while (!open_.empty()) {
+            graph::NodeId u = open_.top().node;
+            open_.pop();
+            if (closed_[u] == generation_) {
+                continue;
+            }
+            closed_[u] = generation_;
+            ++expanded_;
+            PF_COUNT(nodes_expanded, 1);
+            if (u == goal) {
+                return true;
+            }
+
+            const int x = static_cast<int>(u % width_);
+            const int y = static_cast<int>(u / width_);
+
+            // Pruned neighbour directions given the direction we arrived from;
+            // the start and cells next to blocked edges keep all of them
+            int count = 0;
+            auto add = [&](int ddx, int ddy) {
+                directions[count][0] = ddx;
+                directions[count][1] = ddy;
+                ++count;
+            };
+            if (parent_[u] == graph::INVALID_NODE || !regular(x, y)) {
+                for (int dir = 0; dir < 8; ++dir) {
+                    add(graph::GridOccupancy::dx[dir], graph::GridOccupancy::dy[dir]);
+                }
+            } else {
+                const int px = static_cast<int>(parent_[u] % width_);
+                const int py = static_cast<int>(parent_[u] / width_);
+                const int dx = (x > px) - (x < px);
+                const int dy = (y > py) - (y < py);
+                if (dx != 0 && dy != 0) {
+                    add(dx, 0);
+                    add(0, dy);
+                    add(dx, dy);
+                    if (!walkable(x - dx, y)) {
+                        add(-dx, dy);
+                    }
+                    if (!walkable(x, y - dy)) {
+                        add(dx, -dy);
+                    }
+                } else if (dx != 0) {
+                    add(dx, 0);
+                    if (!walkable(x, y - 1)) {
+                        add(dx, -1);
+                    }
+                    if (!walkable(x, y + 1)) {
+                        add(dx, 1);
+                    }
+                } else {
+                    add(0, dy);
+                    if (!walkable(x - 1, y)) {
+                        add(-1, dy);
+                    }
+                    if (!walkable(x + 1, y)) {
+                        add(1, dy);
+                    }
+                }
+            }
+
+            for (int i = 0; i < count; ++i) {
+                auto jump_point = jump(x, y, directions[i][0], directions[i][1], goal_x, goal_y);
+                if (!jump_point) {
+                    continue;
+                }
+                const graph::NodeId v = node_of(jump_point->first, jump_point->second);
+                if (closed_[v] == generation_) {
+                    continue;
+                }
+                double g_v = g_[u] + octile(x, y, jump_point->first, jump_point->second);
+                if (seen_[v] == generation_ && g_v >= g_[v]) {
+                    continue;
+                }
+                seen_[v] = generation_;
+                g_[v] = g_v;
+                parent_[v] = u;
+                PF_COUNT(edges_relaxed, 1);
+                open_.push(g_v + octile(jump_point->first, jump_point->second, goal_x, goal_y), v);
+            }
+        }
+        return false;
+    }
+
+    void JpsPlanner::begin_query() {
+        const std::size_t cell_count = static_cast<std::size_t>(width_) * height_;
+        if (g_.size() < cell_count) {
+            PF_COUNT(bytes_allocated, (cell_count - g_.size()) *
+                     (sizeof(double) + sizeof(graph::NodeId) + 2 * sizeof(std::uint32_t)));
+            g_.resize(cell_count);
+            parent_.resize(cell_count);
+            seen_.resize(cell_count, 0);
+            closed_.resize(cell_count, 0);
+        }
+        if (++generation_ == 0) {
+            std::fill(seen_.begin(), seen_.end(), 0);
+            std::fill(closed_.begin(), closed_.end(), 0);
+            generation_ = 1;
+        }
+        open_.clear();
+    }
+
+} // namespace algorithms
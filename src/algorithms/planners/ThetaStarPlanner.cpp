@@ -0,0 +1,237 @@
+//
+// Implementation of ThetaStarPlanner
+//
+
+#include "../../include/algorithms/ThetaStarPlanner.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace algorithms {
+
+    ThetaStarPlanner::ThetaStarPlanner(std::shared_ptr<graph::GridGraphBuilder> builder, Variant variant)
+        : builder_(std::move(builder)), variant_(variant) {
+        if (!builder_) {
+            throw std::invalid_argument("Grid graph builder must not be null");
+        }
+    }
+
+    std::string ThetaStarPlanner::name() const {
+        return variant_ == Variant::LazyTheta ? "Lazy Theta*" : "Theta*";
+    }
+
+    PathResult ThetaStarPlanner::find_path(const geometry::Scene& scene) {
+        prepare(scene);
+        return find_prepared_path(scene.start, scene.goal);
+    }
+
+    BatchResult ThetaStarPlanner::plan_batch(const geometry::Scene& scene, std::span<const Query> queries) {
+        BatchResult batch;
+        batch.results.reserve(queries.size());
+
+        // Rasterization reports into the batch, each query into its own result
+        instrumentation::ProfileScope profile_scope(batch.profile);
+        auto batch_start = std::chrono::steady_clock::now();
+        prepare(scene);
+
+        const std::string algorithm_name = name();
+        for (const auto& query : queries) {
+            BenchmarkResult& result = batch.results.emplace_back();
+            result.algorithm_name = algorithm_name;
+            instrumentation::ProfileScope query_scope(result.profile);
+
+            auto start_time = std::chrono::steady_clock::now();
+            PathResult path = find_prepared_path(query.start, query.goal);
+            auto end_time = std::chrono::steady_clock::now();
+
+            result.runtime_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+            if (path) {
+                result.path = std::move(*path);
+            }
+        }
+        auto batch_end = std::chrono::steady_clock::now();
+
+        batch.total_ms = std::chrono::duration<double, std::milli>(batch_end - batch_start).count();
+        if (batch.total_ms > 0.0) {
+            batch.queries_per_second = static_cast<double>(queries.size()) * 1000.0 / batch.total_ms;
+        }
+        return batch;
+    }
+
+    void ThetaStarPlanner::prepare(const geometry::Scene& scene) {
+        PF_SCOPED_TIMER("theta.occupancy");
+        occupancy_ = builder_->build_occupancy(scene);
+        obstacles_ = geometry::DiskIndex(scene.obstacles);
+        step_ = builder_->get_grid_step();
+    }
+
+    PathResult ThetaStarPlanner::find_prepared_path(const geometry::Point& start, const geometry::Point& goal) {
+        const int width = occupancy_.width();
+        const int height = occupancy_.height();
+        auto is_free = [this](int gx, int gy) { return occupancy_.is_cell_free(gx, gy); };
+        auto start_cell = graph::find_nearest_cell(width, height, step_, start, builder_->get_snap_radius(), is_free);
+        auto goal_cell = graph::find_nearest_cell(width, height, step_, goal, builder_->get_snap_radius(), is_free);
+        if (!start_cell || !goal_cell) {
+            return std::nullopt;
+        }
+        const auto start_node = static_cast<graph::NodeId>(start_cell->second * width + start_cell->first);
+        const auto goal_node = static_cast<graph::NodeId>(goal_cell->second * width + goal_cell->first);
+        {
+            PF_SCOPED_TIMER("theta.search");
+            if (!search(start_node, goal_node)) {
+                return std::nullopt;
+            }
+        }
+
+        // Turning points front to back; consecutive ones see each other
+        std::vector<geometry::Point> corners;
+        for (graph::NodeId u = goal_node; ; u = parent_[u]) {
+            corners.push_back(cell_point(u));
+            if (parent_[u] == u) {
+                break;
+            }
+        }
+        std::reverse(corners.begin(), corners.end());
+
+        // The exact start and goal replace the first and last cell centers
+        // whenever they see past them
+        geometry::Path path;
+        path.points.push_back(start);
+        std::size_t i = 0;
+        if (line_of_sight(start, corners.size() > 1 ? corners[1] : goal)) {
+            i = 1;
+        }
+        for (; i < corners.size(); ++i) {
+            if (i + 1 == corners.size() && i > 0 && line_of_sight(path.points.back(), goal)) {
+                break;
+            }
+            if (!(corners[i] == path.points.back())) {
+                path.points.push_back(corners[i]);
+            }
+        }
+        if (!(goal == path.points.back())) {
+            path.points.push_back(goal);
+        }
+        return path;
+    }
+
+    geometry::Point ThetaStarPlanner::cell_point(graph::NodeId node) const {
+        const auto width = static_cast<graph::NodeId>(occupancy_.width());
+        return {(static_cast<int>(node % width) + 0.5) * step_, (static_cast<int>(node / width) + 0.5) * step_};
+    }
+
+    bool ThetaStarPlanner::line_of_sight(const geometry::Point& a, const geometry::Point& b) {
+        ++line_of_sight_checks_;
+        PF_COUNT(obstacle_tests, 1);
+        return !obstacles_.intersects_segment(a, b);
+    }
+
+    bool ThetaStarPlanner::search(graph::NodeId start, graph::NodeId goal) {
+        begin_query();
+        expanded_ = 0;
+        line_of_sight_checks_ = 0;
+
+        const int width = occupancy_.width();
+        const int num_directions = builder_->is_diagonal_allowed() ? 8 : 4;
+        const geometry::Point goal_point = cell_point(goal);
+        auto heuristic = [&](const geometry::Point& p) { return p.distance(goal_point); };
+
+        seen_[start] = generation_;
+        g_[start] = 0.0;
+        parent_[start] = start;
+        open_.push(heuristic(cell_point(start)), start);
+
+        while (!open_.empty()) {
+            graph::NodeId u = open_.top().node;
+            open_.pop();
+            if (closed_[u] == generation_) {
+                continue;
+            }
+            closed_[u] = generation_;
+            ++expanded_;
+            PF_COUNT(nodes_expanded, 1);
+
+            const int x = static_cast<int>(u % width);
+            const int y = static_cast<int>(u / width);
+            const geometry::Point u_point = cell_point(u);
+
+            // Lazy Theta*: the parent was assumed visible when u was reached. If
+            // it is not, u hangs off its best expanded neighbour instead; the
+            // cell that reached u is one, so there always is one.
+            if (variant_ == Variant::LazyTheta && parent_[u] != u &&
+                !line_of_sight(cell_point(parent_[u]), u_point)) {
+                g_[u] = std::numeric_limits<double>::infinity();
+                for (int dir = 0; dir < num_directions; ++dir) {
+                    if (!occupancy_.is_edge_free(x, y, dir)) {
+                        continue;
+                    }
+                    const auto v = static_cast<graph::NodeId>((y + graph::GridOccupancy::dy[dir]) * width +
+                                                              x + graph::GridOccupancy::dx[dir]);
+                    if (closed_[v] != generation_) {
+                        continue;
+                    }
+                    double g_u = g_[v] + cell_point(v).distance(u_point);
+                    if (g_u < g_[u]) {
+                        g_[u] = g_u;
+                        parent_[u] = v;
+                    }
+                }
+            }
+
+            if (u == goal) {
+                return true;
+            }
+
+            const graph::NodeId parent = parent_[u];
+            const geometry::Point parent_point = cell_point(parent);
+            for (int dir = 0; dir < num_directions; ++dir) {
+                if (!occupancy_.is_edge_free(x, y, dir)) {
+                    continue;
+                }
+                const auto v = static_cast<graph::NodeId>((y + graph::GridOccupancy::dy[dir]) * width +
+                                                          x + graph::GridOccupancy::dx[dir]);
+                if (closed_[v] == generation_) {
+                    continue;
+                }
+
+                // Path 2 through u's parent if it sees v (Lazy Theta* checks
+                // that on expansion), otherwise path 1 along the grid edge
+                const geometry::Point v_point = cell_point(v);
+                graph::NodeId via = u;
+                double g_v = g_[u] + u_point.distance(v_point);
+                if (parent != u && (variant_ == Variant::LazyTheta || line_of_sight(parent_point, v_point))) {
+                    via = parent;
+                    g_v = g_[parent] + parent_point.distance(v_point);
+                }
+                if (seen_[v] == generation_ && g_v >= g_[v]) {
+                    continue;
+                }
+                seen_[v] = generation_;
+                g_[v] = g_v;
+                parent_[v] = via;
+                PF_COUNT(edges_relaxed, 1);
+                open_.push(g_v + heuristic(v_point), v);
+            }
+        }
+        return false;
+    }
+
+    void ThetaStarPlanner::begin_query() {
+        const std::size_t cell_count = occupancy_.cell_count();
+        if (g_.size() < cell_count) {
+            PF_COUNT(bytes_allocated, (cell_count - g_.size()) *
+                     (sizeof(double) + sizeof(graph::NodeId) + 2 * sizeof(std::uint32_t)));
+            g_.resize(cell_count);
+            parent_.resize(cell_count);
+            seen_.resize(cell_count, 0);
+            closed_.resize(cell_count, 0);
+        }
+        if (++generation_ == 0) {
+            std::fill(seen_.begin(), seen_.end(), 0);
+            std::fill(closed_.begin(), closed_.end(), 0);
+            generation_ = 1;
+        }
+        open_.clear();
+    }
+
+} // namespace algorithms
@@ -0,0 +1,474 @@
+//
+// Headless benchmark: sweeps scene and builder parameters over seeded
+// NaiveObstacleSampler scenes and reports build and query performance
+//
+
+#include "../include/geometry/NaiveObstacleSampler.h"
+#include "../include/algorithms/GridGraphBuilder.h"
+#include "../include/algorithms/TangentGraphBuilder.h"
+#include "../include/algorithms/VisibilityGraphBuilder.h"
+#include "../include/algorithms/AStarPlanner.h"
+#include "../include/algorithms/AStarSearch.h"
+#include "../include/algorithms/BidirectionalPlanner.h"
+#include "../include/algorithms/ThetaStarPlanner.h"
+#include "../include/algorithms/HpaStarPlanner.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    struct SceneParams {
+        std::size_t obstacle_count;
+        double min_radius;
+        double max_radius;
+        double size; // square scenes, size x size
+    };
+
+    struct BenchOptions {
+        std::vector<std::size_t> obstacle_counts {10, 50, 200};
+        std::vector<std::pair<double, double>> radius_ranges {{1.0, 3.0}, {3.0, 8.0}};
+        std::vector<double> scene_sizes {100.0, 400.0};
+        std::vector<double> grid_steps {0.5, 1.0, 2.0};
+        std::vector<int> points_per_obstacle {8, 16};
+        std::vector<std::uint32_t> seeds {1, 2, 3};
+        std::size_t queries = 200;
+        unsigned threads = 0;
+        std::string csv_path;
+        std::string json_path;
+    };
+
+    /**
+     * One row of the report: a builder configuration on one generated scene
+     */
+    struct BenchRow {
+        std::string builder;
+        std::string parameter_name;
+        double parameter = 0.0;
+        SceneParams scene {};
+        std::uint32_t seed = 0;
+
+        double build_ms = 0.0;
+        std::size_t nodes = 0;
+        std::size_t edges = 0;
+        std::size_t graph_bytes = 0;
+
+        // Query columns stay zero for builders benchmarked on build only
+        std::size_t queries = 0;
+        std::size_t paths_found = 0;
+        double query_p50_ms = 0.0;
+        double query_p90_ms = 0.0;
+        double query_p99_ms = 0.0;
+        double queries_per_second = 0.0;
+        double mean_path_length = 0.0;
+
+        // Filled only when built with DIPLOMA_INSTRUMENTATION
+        algorithms::instrumentation::Profile build_profile;
+        algorithms::instrumentation::Profile query_profile; // summed over the queries
+    };
+
+    template <typename Fn>
+    double time_ms(Fn&& fn) {
+        auto start_time = std::chrono::steady_clock::now();
+        fn();
+        auto end_time = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    }
+
+    /**
+     * Nearest-rank percentile of sorted values, p in [0, 1]
+     */
+    double percentile(const std::vector<double>& sorted, double p) {
+        if (sorted.empty()) {
+            return 0.0;
+        }
+        auto rank = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(rank, sorted.size() - 1)];
+    }
+
+    double path_length(const geometry::Path& path) {
+        double length = 0.0;
+        for (std::size_t i = 1; i < path.points.size(); ++i) {
+            length += path.points[i - 1].distance(path.points[i]);
+        }
+        return length;
+    }
+
+    geometry::Scene make_scene(const SceneParams& params, std::uint32_t seed) {
+        geometry::NaiveObstacleSampler sampler(seed);
+        return sampler.sample(
+            params.obstacle_count,
+            params.min_radius,
+            params.max_radius,
+            params.size, params.size,
+            params.size / 2.0, params.size / 2.0,
+            params.size, params.size,
+            std::nullopt,
+            std::nullopt
+        );
+    }
+
+    std::vector<algorithms::Query> make_queries(const geometry::Scene& scene, std::size_t count, std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> x(0.0, scene.width);
+        std::uniform_real_distribution<double> y(0.0, scene.height);
+
+        std::vector<algorithms::Query> queries(count);
+        for (auto& query : queries) {
+            query.start = {x(rng), y(rng)};
+            query.goal = {x(rng), y(rng)};
+        }
+        return queries;
+    }
+
+    void measure_build(algorithms::graph::GraphBuilder& builder, const geometry::Scene& scene, BenchRow& row) {
+        algorithms::graph::Graph graph;
+        algorithms::instrumentation::ProfileScope profile_scope(row.build_profile);
+        row.build_ms = time_ms([&]() { graph = builder.build(scene); });
+        row.nodes = graph.adj.size();
+        for (const auto& edges : graph.adj) {
+            row.edges += edges.size();
+        }
+        row.edges /= 2; // undirected
+        row.graph_bytes = graph.memory_bytes();
+    }
+
+    /**
+     * @param rebuild_per_query use the Planner default, which plans every query
+     *                          on its own scene, for graphs that depend on start/goal
+     */
+    void measure_queries(algorithms::Planner& planner, const geometry::Scene& scene,
+                         const std::vector<algorithms::Query>& queries, bool rebuild_per_query, BenchRow& row) {
+        algorithms::BatchResult batch = rebuild_per_query
+            ? planner.Planner::plan_batch(scene, queries)
+            : planner.plan_batch(scene, queries);
+
+        std::vector<double> latencies;
+        latencies.reserve(batch.results.size());
+        double total_length = 0.0;
+        for (const auto& result : batch.results) {
+            latencies.push_back(result.runtime_ms);
+            row.query_profile += result.profile;
+            if (!result.path.points.empty()) {
+                ++row.paths_found;
+                total_length += path_length(result.path);
+            }
+        }
+        std::sort(latencies.begin(), latencies.end());
+
+        row.queries = queries.size();
+        row.query_p50_ms = percentile(latencies, 0.50);
+        row.query_p90_ms = percentile(latencies, 0.90);
+        row.query_p99_ms = percentile(latencies, 0.99);
+        row.queries_per_second = batch.queries_per_second;
+        if (row.paths_found > 0) {
+            row.mean_path_length = total_length / static_cast<double>(row.paths_found);
+        }
+    }
+
+    /**
+     * Builds the implicit grid and answers the queries with A* over it directly:
+     * no adjacency lists, neighbours come from the occupancy bitmap
+     */
+    void measure_implicit(const algorithms::graph::GridGraphBuilder& builder, const geometry::Scene& scene,
+                          const std::vector<algorithms::Query>& queries, BenchRow& row) {
+        algorithms::graph::ImplicitGridGraph graph;
+        {
+            algorithms::instrumentation::ProfileScope profile_scope(row.build_profile);
+            row.build_ms = time_ms([&]() { graph = builder.build_implicit(scene); });
+        }
+        for (algorithms::graph::NodeId u = 0; u < graph.node_count(); ++u) {
+            if (graph.is_node(u)) {
+                ++row.nodes;
+                graph.for_each_neighbor(u, [&](algorithms::graph::NodeId, double) { ++row.edges; });
+            }
+        }
+        row.edges /= 2; // undirected
+        row.graph_bytes = graph.memory_bytes();
+
+        algorithms::AStarSearch<algorithms::OctileHeuristic> search;
+        auto node_point = [&](algorithms::graph::NodeId u) { return graph.get_node_point(u); };
+        std::vector<double> latencies;
+        latencies.reserve(queries.size());
+        double total_length = 0.0;
+        double total_ms = 0.0;
+        algorithms::instrumentation::ProfileScope profile_scope(row.query_profile);
+        for (const auto& query : queries) {
+            geometry::Path path;
+            double ms = time_ms([&]() {
+                auto start = graph.get_node_id(query.start);
+                auto goal = graph.get_node_id(query.goal);
+                if (!start || !goal || !search.search(graph, node_point, *start, *goal)) {
+                    return;
+                }
+                path.points.push_back(query.start);
+                for (algorithms::graph::NodeId u : search.path()) {
+                    path.points.push_back(graph.get_node_point(u));
+                }
+                path.points.push_back(query.goal);
+            });
+            latencies.push_back(ms);
+            total_ms += ms;
+            if (!path.points.empty()) {
+                ++row.paths_found;
+                total_length += path_length(path);
+            }
+        }
+        std::sort(latencies.begin(), latencies.end());
+
+        row.queries = queries.size();
+        row.query_p50_ms = percentile(latencies, 0.50);
+        row.query_p90_ms = percentile(latencies, 0.90);
+        row.query_p99_ms = percentile(latencies, 0.99);
+        if (total_ms > 0.0) {
+            row.queries_per_second = static_cast<double>(queries.size()) * 1000.0 / total_ms;
+        }
+        if (row.paths_found > 0) {
+            row.mean_path_length = total_length / static_cast<double>(row.paths_found);
+        }
+    }
+
+    std::vector<BenchRow> run(const BenchOptions& options) {
+        std::vector<BenchRow> rows;
+
+        for (std::size_t obstacle_count : options.obstacle_counts) {
+            for (const auto& [min_radius, max_radius] : options.radius_ranges) {
+                for (double size : options.scene_sizes) {
+                    const SceneParams params {obstacle_count, min_radius, max_radius, size};
+                    for (std::uint32_t seed : options.seeds) {
+                        const geometry::Scene scene = make_scene(params, seed);
+                        const auto queries = make_queries(scene, options.queries, seed);
+
+                        auto base_row = [&](std::string builder, std::string parameter_name, double parameter) {
+                            BenchRow row;
+                            row.builder = std::move(builder);
+                            row.parameter_name = std::move(parameter_name);
+                            row.parameter = parameter;
+                            row.scene = params;
+                            row.seed = seed;
+                            return row;
+                        };
+
+                        for (double grid_step : options.grid_steps) {
+                            auto builder = std::make_shared<algorithms::graph::GridGraphBuilder>(grid_step, true);
+                            builder->set_thread_count(options.threads);
+                            BenchRow row = base_row(builder->name(), "grid_step", grid_step);
+                            measure_build(*builder, scene, row);
+
+                            algorithms::AStarPlanner<algorithms::OctileHeuristic> planner(
+                                builder, algorithms::make_node_locator(builder));
+                            planner.set_thread_count(options.threads);
+                            measure_queries(planner, scene, queries, false, row);
+                            rows.push_back(std::move(row));
+
+                            // Same graph and heuristic, searched from both ends
+                            algorithms::BidirectionalPlanner<algorithms::OctileHeuristic> bidirectional_planner(
+                                builder, algorithms::make_node_locator(builder));
+                            bidirectional_planner.set_thread_count(options.threads);
+                            BenchRow bidirectional_row = base_row(bidirectional_planner.name(), "grid_step", grid_step);
+                            measure_queries(bidirectional_planner, scene, queries, false, bidirectional_row);
+                            rows.push_back(std::move(bidirectional_row));
+
+                            // Any-angle paths on the same grid, without a graph
+                            algorithms::ThetaStarPlanner theta_planner(builder);
+                            BenchRow theta_row = base_row(theta_planner.name(), "grid_step", grid_step);
+                            measure_queries(theta_planner, scene, queries, false, theta_row);
+                            rows.push_back(std::move(theta_row));
+
+                            // Hierarchical search over clusters of the same grid
+                            algorithms::HpaStarPlanner hpa_planner(builder);
+                            hpa_planner.set_thread_count(options.threads);
+                            BenchRow hpa_row = base_row(hpa_planner.name(), "grid_step", grid_step);
+                            measure_queries(hpa_planner, scene, queries, false, hpa_row);
+                            rows.push_back(std::move(hpa_row));
+
+                            // Same grid and heuristic without adjacency lists
+                            BenchRow implicit_row = base_row(builder->name() + " (implicit)", "grid_step", grid_step);
+                            measure_implicit(*builder, scene, queries, implicit_row);
+                            rows.push_back(std::move(implicit_row));
+                        }
+
+                        {
+                            auto builder = std::make_shared<algorithms::graph::TangentGraphBuilder>();
+                            BenchRow row = base_row(builder->name(), "arc_step", builder->get_arc_step());
+                            measure_build(*builder, scene, row);
+
+                            // The tangent graph depends on start and goal, so each query rebuilds it
+                            algorithms::AStarPlanner<algorithms::EuclideanHeuristic> planner(
+                                builder, algorithms::make_node_locator(builder));
+                            measure_queries(planner, scene, queries, true, row);
+                            rows.push_back(std::move(row));
+                        }
+
+                        // Sampled visibility graphs are benchmarked on build only
+                        for (int points : options.points_per_obstacle) {
+                            algorithms::graph::VisibilityGraphBuilder builder(points);
+                            BenchRow row = base_row(builder.name(), "points_per_obstacle", points);
+                            measure_build(builder, scene, row);
+                            rows.push_back(std::move(row));
+                        }
+                    }
+                }
+            }
+        }
+        return rows;
+    }
+
+    void write_csv(std::ostream& out, const std::vector<BenchRow>& rows) {
+        out << "builder,parameter_name,parameter,obstacles,min_radius,max_radius,scene_size,seed,"
+               "build_ms,nodes,edges,graph_bytes,queries,paths_found,"
+               "query_p50_ms,query_p90_ms,query_p99_ms,queries_per_second,mean_path_length,"
+               "build_obstacle_tests,build_bytes_allocated,"
+               "query_nodes_expanded,query_heap_pushes,query_heap_pops,query_edges_relaxed\n";
+        for (const auto& row : rows) {
+            out << '"' << row.builder << "\"," << row.parameter_name << ',' << row.parameter << ','
+                << row.scene.obstacle_count << ',' << row.scene.min_radius << ',' << row.scene.max_radius << ','
+                << row.scene.size << ',' << row.seed << ','
+                << row.build_ms << ',' << row.nodes << ',' << row.edges << ',' << row.graph_bytes << ','
+                << row.queries << ',' << row.paths_found << ','
+                << row.query_p50_ms << ',' << row.query_p90_ms << ',' << row.query_p99_ms << ','
+                << row.queries_per_second << ',' << row.mean_path_length << ','
+                << row.build_profile.counters.obstacle_tests << ',' << row.build_profile.counters.bytes_allocated << ','
+                << row.query_profile.counters.nodes_expanded << ',' << row.query_profile.counters.heap_pushes << ','
+                << row.query_profile.counters.heap_pops << ',' << row.query_profile.counters.edges_relaxed << '\n';
+        }
+    }
+
+    nlohmann::json to_json(const algorithms::instrumentation::Profile& profile) {
+        const auto& counters = profile.counters;
+        nlohmann::json phases = nlohmann::json::object();
+        for (const auto& phase : profile.phases) {
+            phases[phase.name] = phase.ms;
+        }
+        return {
+            {"phases_ms", phases},
+            {"obstacle_tests", counters.obstacle_tests},
+            {"nodes_expanded", counters.nodes_expanded},
+            {"heap_pushes", counters.heap_pushes},
+            {"heap_pops", counters.heap_pops},
+            {"edges_relaxed", counters.edges_relaxed},
+            {"bytes_allocated", counters.bytes_allocated}
+        };
+    }
+
+    nlohmann::json to_json(const std::vector<BenchRow>& rows) {
+        nlohmann::json j = nlohmann::json::array();
+        for (const auto& row : rows) {
+            nlohmann::json& entry = j.emplace_back(nlohmann::json{
+                {"builder", row.builder},
+                {row.parameter_name, row.parameter},
+                {"scene", {
+                    {"obstacles", row.scene.obstacle_count},
+                    {"min_radius", row.scene.min_radius},
+                    {"max_radius", row.scene.max_radius},
+                    {"size", row.scene.size},
+                    {"seed", row.seed}
+                }},
+                {"build", {
+                    {"ms", row.build_ms},
+                    {"nodes", row.nodes},
+                    {"edges", row.edges},
+                    {"graph_bytes", row.graph_bytes}
+                }},
+                {"query", {
+                    {"count", row.queries},
+                    {"paths_found", row.paths_found},
+                    {"p50_ms", row.query_p50_ms},
+                    {"p90_ms", row.query_p90_ms},
+                    {"p99_ms", row.query_p99_ms},
+                    {"queries_per_second", row.queries_per_second},
+                    {"mean_path_length", row.mean_path_length}
+                }}
+            });
+            if (algorithms::instrumentation::ENABLED) {
+                entry["build"]["profile"] = to_json(row.build_profile);
+                entry["query"]["profile"] = to_json(row.query_profile);
+            }
+        }
+        return j;
+    }
+
+    void print_usage() {
+        std::cout << "Usage: bench [--csv FILE] [--json FILE] [--queries N] [--threads N] [--quick]\n"
+                  << "  Without --csv or --json the CSV report goes to stdout.\n"
+                  << "  --quick runs a single small configuration.\n";
+    }
+
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+            return argv[++i];
+        };
+
+        try {
+            if (arg == "--csv") {
+                options.csv_path = value();
+            } else if (arg == "--json") {
+                options.json_path = value();
+            } else if (arg == "--queries") {
+                options.queries = std::stoul(value());
+            } else if (arg == "--threads") {
+                options.threads = static_cast<unsigned>(std::stoul(value()));
+            } else if (arg == "--quick") {
+                options.obstacle_counts = {20};
+                options.radius_ranges = {{2.0, 5.0}};
+                options.scene_sizes = {100.0};
+                options.grid_steps = {1.0};
+                options.points_per_obstacle = {8};
+                options.seeds = {1};
+            } else if (arg == "--help" || arg == "-h") {
+                print_usage();
+                return 0;
+            } else {
+                throw std::invalid_argument("Unknown argument " + arg);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "ERROR: " << e.what() << "\n";
+            print_usage();
+            return 1;
+        }
+    }
+
+    const std::vector<BenchRow> rows = run(options);
+
+    if (options.csv_path.empty() && options.json_path.empty()) {
+        write_csv(std::cout, rows);
+        return 0;
+    }
+    if (!options.csv_path.empty()) {
+        std::ofstream file(options.csv_path);
+        if (!file) {
+            std::cerr << "ERROR: Failed to open " << options.csv_path << "\n";
+            return 1;
+        }
+        write_csv(file, rows);
+    }
+    if (!options.json_path.empty()) {
+        std::ofstream file(options.json_path);
+        if (!file) {
+            std::cerr << "ERROR: Failed to open " << options.json_path << "\n";
+            return 1;
+        }
+        file << to_json(rows).dump(2) << "\n";
+    }
+    std::cout << "Wrote " << rows.size() << " rows\n";
+    return 0;
+}
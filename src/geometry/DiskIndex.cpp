@@ -0,0 +1,177 @@
+//
+// Implementation of DiskIndex
+//
+
+#include "../include/geometry/DiskIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace geometry {
+
+    DiskIndex::DiskIndex(std::span<const Disk> disks, double cell_size)
+        : disks_(disks.begin(), disks.end()) {
+        bucket_offsets_.assign(1, 0);
+        if (disks_.empty()) {
+            return;
+        }
+
+        double min_x = std::numeric_limits<double>::max();
+        double min_y = std::numeric_limits<double>::max();
+        double max_x = std::numeric_limits<double>::lowest();
+        double max_y = std::numeric_limits<double>::lowest();
+        double radius_sum = 0.0;
+        for (const auto& disk : disks_) {
+            min_x = std::min(min_x, disk.center.x - disk.radius);
+            min_y = std::min(min_y, disk.center.y - disk.radius);
+            max_x = std::max(max_x, disk.center.x + disk.radius);
+            max_y = std::max(max_y, disk.center.y + disk.radius);
+            radius_sum += disk.radius;
+        }
+
+        // Buckets about one average disk wide, but never more than ~4 per disk
+        const double extent_x = max_x - min_x;
+        const double extent_y = max_y - min_y;
+        const double count = static_cast<double>(disks_.size());
+        if (cell_size <= 0.0) {
+            cell_size = 2.0 * radius_sum / count;
+        }
+        cell_size = std::max(cell_size, std::sqrt(extent_x * extent_y / (4.0 * count)));
+        if (!(cell_size > 0.0)) {
+            cell_size = 1.0;
+        }
+
+        cell_size_ = cell_size;
+        origin_x_ = min_x;
+        origin_y_ = min_y;
+        columns_ = static_cast<int>(std::floor(extent_x / cell_size_)) + 1;
+        rows_ = static_cast<int>(std::floor(extent_y / cell_size_)) + 1;
+
+        // Counting pass, prefix sum, fill pass
+        const std::size_t bucket_count = static_cast<std::size_t>(columns_) * rows_;
+        std::vector<std::uint32_t> counts(bucket_count + 1, 0);
+        auto for_each_bucket = [this](const Disk& disk, auto&& fn) {
+            int x0 = clamp_x(bucket_x(disk.center.x - disk.radius));
+            int x1 = clamp_x(bucket_x(disk.center.x + disk.radius));
+            int y0 = clamp_y(bucket_y(disk.center.y - disk.radius));
+            int y1 = clamp_y(bucket_y(disk.center.y + disk.radius));
+            for (int by = y0; by <= y1; ++by) {
+                for (int bx = x0; bx <= x1; ++bx) {
+                    fn(static_cast<std::size_t>(by) * columns_ + bx);
+                }
+            }
+        };
+
+        for (const auto& disk : disks_) {
+            for_each_bucket(disk, [&](std::size_t bucket) { ++counts[bucket + 1]; });
+        }
+        for (std::size_t b = 0; b < bucket_count; ++b) {
+            counts[b + 1] += counts[b];
+        }
+        bucket_offsets_ = counts;
+        bucket_items_.resize(bucket_offsets_.back());
+        for (std::size_t i = 0; i < disks_.size(); ++i) {
+            for_each_bucket(disks_[i], [&](std::size_t bucket) {
+                bucket_items_[counts[bucket]++] = static_cast<std::uint32_t>(i);
+            });
+        }
+        bucket_disks_.reserve(bucket_items_.size());
+        for (std::uint32_t item : bucket_items_) {
+            bucket_disks_.push_back(disks_[item]);
+        }
+    }
+
+    bool DiskIndex::contains(const Point& p) const {
+        return find_containing(p).has_value();
+    }
+
+    std::optional<std::size_t> DiskIndex::find_containing(const Point& p) const {
+        if (disks_.empty()) {
+            return std::nullopt;
+        }
+        int bx = bucket_x(p.x);
+        int by = bucket_y(p.y);
+        if (bx < 0 || bx >= columns_ || by < 0 || by >= rows_) {
+            return std::nullopt;
+        }
+        std::size_t bucket = static_cast<std::size_t>(by) * columns_ + bx;
+        const std::size_t end = bucket_offsets_[bucket + 1];
+        std::size_t i = bucket_disks_.first_containing(p, bucket_offsets_[bucket], end);
+        if (i == end) {
+            return std::nullopt;
+        }
+        return bucket_items_[i];
+    }
+
+    bool DiskIndex::intersects_segment(const Point& a, const Point& b) const {
+        return any_intersecting(a, b, 0.0, [](std::size_t) { return true; });
+    }
+
+    std::vector<std::size_t> DiskIndex::k_nearest(const Point& p, std::size_t k) const {
+        std::vector<std::size_t> result;
+        if (disks_.empty() || k == 0) {
+            return result;
+        }
+
+        auto distance_to = [&](std::size_t i) {
+            return std::max(0.0, disks_[i].center.distance(p) - disks_[i].radius);
+        };
+
+        // Candidates may repeat (a disk spans several buckets) but always with
+        // the same distance, so sorting by (distance, position) makes them adjacent
+        std::vector<std::pair<double, std::size_t>> candidates;
+        auto unique_candidates = [&]() {
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        };
+
+        const int px = bucket_x(p.x);
+        const int py = bucket_y(p.y);
+        const int first_ring = std::max({0, -px, px - (columns_ - 1), -py, py - (rows_ - 1)});
+        const int last_ring = std::max({px, columns_ - 1 - px, py, rows_ - 1 - py});
+
+        for (int ring = first_ring; ring <= last_ring; ++ring) {
+            int y_begin = std::max(py - ring, 0);
+            int y_end = std::min(py + ring, rows_ - 1);
+            for (int by = y_begin; by <= y_end; ++by) {
+                bool full_row = (by == py - ring || by == py + ring);
+                int step = full_row ? 1 : 2 * ring;
+                for (int bx = px - ring; bx <= px + ring; bx += step) {
+                    if (bx < 0 || bx >= columns_) {
+                        continue;
+                    }
+                    std::size_t bucket = static_cast<std::size_t>(by) * columns_ + bx;
+                    for (std::uint32_t i = bucket_offsets_[bucket]; i < bucket_offsets_[bucket + 1]; ++i) {
+                        candidates.emplace_back(distance_to(bucket_items_[i]), bucket_items_[i]);
+                    }
+                }
+            }
+
+            // Disks not seen yet lie outside this ring, at least ring * cell_size away
+            if (candidates.size() >= k) {
+                unique_candidates();
+                if (candidates.size() >= k && candidates[k - 1].first <= ring * cell_size_) {
+                    break;
+                }
+            }
+        }
+
+        unique_candidates();
+        for (std::size_t i = 0; i < candidates.size() && i < k; ++i) {
+            result.push_back(candidates[i].second);
+        }
+        return result;
+    }
+
+    int DiskIndex::bucket_x(double x) const {
+        double b = std::floor((x - origin_x_) / cell_size_);
+        return static_cast<int>(std::clamp(b, -1.0e9, 1.0e9));
+    }
+
+    int DiskIndex::bucket_y(double y) const {
+        double b = std::floor((y - origin_y_) / cell_size_);
+        return static_cast<int>(std::clamp(b, -1.0e9, 1.0e9));
+    }
+
+} // namespace geometry
@@ -0,0 +1,262 @@
+//
+// Implementation of DiskSet
+//
+
+#include "../include/geometry/DiskSet.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#define GEOMETRY_DISK_SET_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// AVX2 code is compiled per function with a target attribute, so the rest of
+// the library keeps the baseline instruction set
+#if defined(GEOMETRY_DISK_SET_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define GEOMETRY_DISK_SET_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace geometry {
+
+    namespace {
+
+        // Segment [a, b] as used by every kernel; t of the closest point to c is
+        // ((c - a) . d) * inv_length_sq clamped to [0, 1]
+        struct Segment {
+            double ax;
+            double ay;
+            double dx;
+            double dy;
+            double inv_length_sq; // 0 for a degenerate segment, so t = 0
+            double tolerance;
+        };
+
+        // The scalar loops are inlined into every kernel for the tail, so the AVX2
+        // kernels never call into legacy-SSE code (which would pay the AVX/SSE
+        // transition penalty on every call)
+        inline std::size_t first_containing_scalar(const double* x, const double* y, const double* r,
+                                                   std::size_t begin, std::size_t end, double px, double py) {
+            for (std::size_t i = begin; i < end; ++i) {
+                double dx = x[i] - px;
+                double dy = y[i] - py;
+                if (dx * dx + dy * dy <= r[i] * r[i]) {
+                    return i;
+                }
+            }
+            return end;
+        }
+
+        inline std::size_t first_intersecting_scalar(const double* x, const double* y, const double* r,
+                                                     std::size_t begin, std::size_t end, const Segment& s) {
+            for (std::size_t i = begin; i < end; ++i) {
+                double t = ((x[i] - s.ax) * s.dx + (y[i] - s.ay) * s.dy) * s.inv_length_sq;
+                t = std::max(std::min(t, 1.0), 0.0);
+                double ex = (s.ax + t * s.dx) - x[i];
+                double ey = (s.ay + t * s.dy) - y[i];
+                double radius = r[i] - s.tolerance * (1.0 + r[i]);
+                if (radius >= 0.0 && ex * ex + ey * ey <= radius * radius) {
+                    return i;
+                }
+            }
+            return end;
+        }
+
+#ifdef GEOMETRY_DISK_SET_SSE2
+        std::size_t first_containing_sse2(const double* x, const double* y, const double* r,
+                                          std::size_t begin, std::size_t end, double px, double py) {
+            const __m128d vpx = _mm_set1_pd(px);
+            const __m128d vpy = _mm_set1_pd(py);
+            std::size_t i = begin;
+            for (; i + 2 <= end; i += 2) {
+                __m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i), vpx);
+                __m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i), vpy);
+                __m128d vr = _mm_loadu_pd(r + i);
+                __m128d distance_sq = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+                int mask = _mm_movemask_pd(_mm_cmple_pd(distance_sq, _mm_mul_pd(vr, vr)));
+                if (mask != 0) {
+                    return i + std::countr_zero(static_cast<unsigned>(mask));
+                }
+            }
+            return first_containing_scalar(x, y, r, i, end, px, py);
+        }
+
+        std::size_t first_intersecting_sse2(const double* x, const double* y, const double* r,
+                                            std::size_t begin, std::size_t end, const Segment& s) {
+            const __m128d ax = _mm_set1_pd(s.ax);
+            const __m128d ay = _mm_set1_pd(s.ay);
+            const __m128d dx = _mm_set1_pd(s.dx);
+            const __m128d dy = _mm_set1_pd(s.dy);
+            const __m128d inv_length_sq = _mm_set1_pd(s.inv_length_sq);
+            const __m128d tolerance = _mm_set1_pd(s.tolerance);
+            const __m128d zero = _mm_setzero_pd();
+            const __m128d one = _mm_set1_pd(1.0);
+            std::size_t i = begin;
+            for (; i + 2 <= end; i += 2) {
+                __m128d cx = _mm_loadu_pd(x + i);
+                __m128d cy = _mm_loadu_pd(y + i);
+                __m128d vr = _mm_loadu_pd(r + i);
+                __m128d dot = _mm_add_pd(_mm_mul_pd(_mm_sub_pd(cx, ax), dx), _mm_mul_pd(_mm_sub_pd(cy, ay), dy));
+                __m128d t = _mm_max_pd(_mm_min_pd(_mm_mul_pd(dot, inv_length_sq), one), zero);
+                __m128d ex = _mm_sub_pd(_mm_add_pd(ax, _mm_mul_pd(t, dx)), cx);
+                __m128d ey = _mm_sub_pd(_mm_add_pd(ay, _mm_mul_pd(t, dy)), cy);
+                __m128d radius = _mm_sub_pd(vr, _mm_mul_pd(tolerance, _mm_add_pd(one, vr)));
+                __m128d distance_sq = _mm_add_pd(_mm_mul_pd(ex, ex), _mm_mul_pd(ey, ey));
+                __m128d hit = _mm_and_pd(_mm_cmpge_pd(radius, zero),
+                                         _mm_cmple_pd(distance_sq, _mm_mul_pd(radius, radius)));
+                int mask = _mm_movemask_pd(hit);
+                if (mask != 0) {
+                    return i + std::countr_zero(static_cast<unsigned>(mask));
+                }
+            }
+            return first_intersecting_scalar(x, y, r, i, end, s);
+        }
+#endif
+
+#ifdef GEOMETRY_DISK_SET_AVX2
+        __attribute__((target("avx2")))
+        std::size_t first_containing_avx2(const double* x, const double* y, const double* r,
+                                          std::size_t begin, std::size_t end, double px, double py) {
+            const __m256d vpx = _mm256_set1_pd(px);
+            const __m256d vpy = _mm256_set1_pd(py);
+            std::size_t i = begin;
+            for (; i + 4 <= end; i += 4) {
+                __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), vpx);
+                __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), vpy);
+                __m256d vr = _mm256_loadu_pd(r + i);
+                __m256d distance_sq = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+                int mask = _mm256_movemask_pd(_mm256_cmp_pd(distance_sq, _mm256_mul_pd(vr, vr), _CMP_LE_OQ));
+                if (mask != 0) {
+                    return i + std::countr_zero(static_cast<unsigned>(mask));
+                }
+            }
+            return first_containing_scalar(x, y, r, i, end, px, py);
+        }
+
+        __attribute__((target("avx2")))
+        std::size_t first_intersecting_avx2(const double* x, const double* y, const double* r,
+                                            std::size_t begin, std::size_t end, const Segment& s) {
+            const __m256d ax = _mm256_set1_pd(s.ax);
+            const __m256d ay = _mm256_set1_pd(s.ay);
+            const __m256d dx = _mm256_set1_pd(s.dx);
+            const __m256d dy = _mm256_set1_pd(s.dy);
+            const __m256d inv_length_sq = _mm256_set1_pd(s.inv_length_sq);
+            const __m256d tolerance = _mm256_set1_pd(s.tolerance);
+            const __m256d zero = _mm256_setzero_pd();
+            const __m256d one = _mm256_set1_pd(1.0);
+            std::size_t i = begin;
+            for (; i + 4 <= end; i += 4) {
+                __m256d cx = _mm256_loadu_pd(x + i);
+                __m256d cy = _mm256_loadu_pd(y + i);
+                __m256d vr = _mm256_loadu_pd(r + i);
+                __m256d dot = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(cx, ax), dx),
+                                            _mm256_mul_pd(_mm256_sub_pd(cy, ay), dy));
+                __m256d t = _mm256_max_pd(_mm256_min_pd(_mm256_mul_pd(dot, inv_length_sq), one), zero);
+                __m256d ex = _mm256_sub_pd(_mm256_add_pd(ax, _mm256_mul_pd(t, dx)), cx);
+                __m256d ey = _mm256_sub_pd(_mm256_add_pd(ay, _mm256_mul_pd(t, dy)), cy);
+                __m256d radius = _mm256_sub_pd(vr, _mm256_mul_pd(tolerance, _mm256_add_pd(one, vr)));
+                __m256d distance_sq = _mm256_add_pd(_mm256_mul_pd(ex, ex), _mm256_mul_pd(ey, ey));
+                __m256d hit = _mm256_and_pd(_mm256_cmp_pd(radius, zero, _CMP_GE_OQ),
+                                            _mm256_cmp_pd(distance_sq, _mm256_mul_pd(radius, radius), _CMP_LE_OQ));
+                int mask = _mm256_movemask_pd(hit);
+                if (mask != 0) {
+                    return i + std::countr_zero(static_cast<unsigned>(mask));
+                }
+            }
+            return first_intersecting_scalar(x, y, r, i, end, s);
+        }
+#endif
+
+        DiskSet::SimdLevel supported_level() {
+#ifdef GEOMETRY_DISK_SET_AVX2
+            if (__builtin_cpu_supports("avx2")) {
+                return DiskSet::SimdLevel::Avx2;
+            }
+#endif
+#ifdef GEOMETRY_DISK_SET_SSE2
+            return DiskSet::SimdLevel::Sse2;
+#else
+            return DiskSet::SimdLevel::Scalar;
+#endif
+        }
+
+        std::atomic<DiskSet::SimdLevel>& active_level() {
+            static std::atomic<DiskSet::SimdLevel> level(supported_level());
+            return level;
+        }
+
+    }
+
+    DiskSet::DiskSet(std::span<const Disk> disks) {
+        reserve(disks.size());
+        for (const auto& disk : disks) {
+            push_back(disk);
+        }
+    }
+
+    void DiskSet::reserve(std::size_t count) {
+        x_.reserve(count);
+        y_.reserve(count);
+        radius_.reserve(count);
+    }
+
+    void DiskSet::push_back(const Disk& disk) {
+        x_.push_back(disk.center.x);
+        y_.push_back(disk.center.y);
+        radius_.push_back(disk.radius);
+    }
+
+    void DiskSet::clear() {
+        x_.clear();
+        y_.clear();
+        radius_.clear();
+    }
+
+    std::size_t DiskSet::first_containing(const Point& p, std::size_t begin, std::size_t end) const {
+        switch (active_level().load(std::memory_order_relaxed)) {
+#ifdef GEOMETRY_DISK_SET_AVX2
+            case SimdLevel::Avx2:
+                return first_containing_avx2(x_.data(), y_.data(), radius_.data(), begin, end, p.x, p.y);
+#endif
+#ifdef GEOMETRY_DISK_SET_SSE2
+            case SimdLevel::Sse2:
+                return first_containing_sse2(x_.data(), y_.data(), radius_.data(), begin, end, p.x, p.y);
+#endif
+            default:
+                return first_containing_scalar(x_.data(), y_.data(), radius_.data(), begin, end, p.x, p.y);
+        }
+    }
+
+    std::size_t DiskSet::first_intersecting(const Point& a, const Point& b,
+                                            std::size_t begin, std::size_t end, double tolerance) const {
+        Segment s {a.x, a.y, b.x - a.x, b.y - a.y, 0.0, tolerance};
+        double length_sq = s.dx * s.dx + s.dy * s.dy;
+        if (length_sq > 0.0) {
+            s.inv_length_sq = 1.0 / length_sq;
+        }
+
+        switch (active_level().load(std::memory_order_relaxed)) {
+#ifdef GEOMETRY_DISK_SET_AVX2
+            case SimdLevel::Avx2:
+                return first_intersecting_avx2(x_.data(), y_.data(), radius_.data(), begin, end, s);
+#endif
+#ifdef GEOMETRY_DISK_SET_SSE2
+            case SimdLevel::Sse2:
+                return first_intersecting_sse2(x_.data(), y_.data(), radius_.data(), begin, end, s);
+#endif
+            default:
+                return first_intersecting_scalar(x_.data(), y_.data(), radius_.data(), begin, end, s);
+        }
+    }
+
+    DiskSet::SimdLevel DiskSet::simd_level() {
+        return active_level().load(std::memory_order_relaxed);
+    }
+
+    void DiskSet::set_simd_level(SimdLevel level) {
+        active_level().store(std::min(level, supported_level()), std::memory_order_relaxed);
+    }
+
+} // namespace geometry
@@ -0,0 +1,336 @@
+//
+// Implementation of VisibilitySweep
+//
+
+#include "../include/geometry/VisibilitySweep.h"
+#include <algorithm>
+#include <cmath>
+
+namespace geometry {
+
+    namespace {
+
+        constexpr double PI = 3.14159265358979323846;
+        constexpr double TWO_PI = 2.0 * PI;
+
+        // Angular slack around each disk's interval; the exact segment test
+        // decides the borderline cases. Also the step past a swap event at
+        // which the two swapped disks are ordered again.
+        constexpr double ANGLE_EPSILON = 1e-9;
+
+        bool blocks(const Disk& disk, const Point& a, const Point& b) {
+            return disk.distance_to_segment(a, b) < disk.radius - 1e-9 * (1.0 + disk.radius);
+        }
+
+        // Brings an angle within one turn of [-pi, pi) into it
+        double normalize(double angle) {
+            if (angle < -PI) {
+                return angle + TWO_PI;
+            }
+            return angle >= PI ? angle - TWO_PI : angle;
+        }
+
+    }
+
+    bool VisibilitySweep::EntryOrder::operator()(std::uint32_t a, std::uint32_t b) const {
+        double entry_a = sweep->entry(a);
+        double entry_b = sweep->entry(b);
+        return entry_a != entry_b ? entry_a < entry_b : a < b;
+    }
+
+    VisibilitySweep::VisibilitySweep(std::span<const Disk> disks)
+        : disks_(disks.begin(), disks.end()),
+          index_(disks_),
+          active_(EntryOrder{this}, &active_nodes_) {
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+        for (std::uint32_t a = 0; a < disks_.size(); ++a) {
+            const Disk& disk = disks_[a];
+            index_.for_each_candidate(
+                {disk.center.x - disk.radius, disk.center.y - disk.radius},
+                {disk.center.x + disk.radius, disk.center.y + disk.radius},
+                [&](std::size_t b) {
+                    if (b > a && disk.center.distance(disks_[b].center) < disk.radius + disks_[b].radius) {
+                        pairs.emplace_back(a, static_cast<std::uint32_t>(b));
+                    }
+                });
+        }
+        // A disk spanning several buckets is reported once per bucket
+        std::sort(pairs.begin(), pairs.end());
+        pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+        for (auto [a, b] : pairs) {
+            const Disk& first = disks_[a];
+            const Disk& second = disks_[b];
+            double d = first.center.distance(second.center);
+            if (d <= std::abs(first.radius - second.radius)) {
+                continue; // nested: the boundaries never cross
+            }
+            double along = (first.radius * first.radius - second.radius * second.radius + d * d) / (2.0 * d);
+            double across = std::sqrt(std::max(0.0, first.radius * first.radius - along * along));
+            double ux = (second.center.x - first.center.x) / d;
+            double uy = (second.center.y - first.center.y) / d;
+            for (double side : {1.0, -1.0}) {
+                crossings_.push_back({{first.center.x + along * ux - side * across * uy,
+                                       first.center.y + along * uy + side * across * ux}, a, b});
+            }
+        }
+    }
+
+    void VisibilitySweep::visible_from(const Point& viewpoint, std::span<const Target> targets,
+                                       std::vector<bool>& visible) {
+        visible.assign(targets.size(), false);
+        segments_.clear();
+        for (std::uint32_t i = 0; i < targets.size(); ++i) {
+            // A target strictly inside another disk is hidden by it
+            if (!is_covered(viewpoint, targets[i].disk, NO_DISK) &&
+                !is_covered(targets[i].point, targets[i].disk, NO_DISK)) {
+                segments_.push_back({viewpoint, targets[i].point, targets[i].disk, i, false});
+            }
+        }
+        if (segments_.empty()) {
+            return;
+        }
+        prepare(viewpoint, 0.0, NO_DISK);
+        sweep(1.0, visible);
+    }
+
+    void VisibilitySweep::visible_along_tangents(std::size_t source, std::span<const TangentTarget> targets,
+                                                 std::vector<bool>& visible) {
+        visible.assign(targets.size(), false);
+        const Disk& disk = disks_[source];
+        segments_.clear();
+        for (std::uint32_t i = 0; i < targets.size(); ++i) {
+            const TangentTarget& target = targets[i];
+            if (is_covered(target.from, source, target.disk) || is_covered(target.to, source, target.disk)) {
+                continue;
+            }
+            double turn = (target.from.x - disk.center.x) * (target.to.y - target.from.y) -
+                          (target.from.y - disk.center.y) * (target.to.x - target.from.x);
+            segments_.push_back({target.from, target.to, target.disk, i, turn < 0.0});
+        }
+        if (segments_.empty()) {
+            return;
+        }
+        // Segments turning counter-clockwise and clockwise round the source lie
+        // on different ray families
+        prepare(disk.center, disk.radius, source);
+        sweep(1.0, visible);
+        sweep(-1.0, visible);
+    }
+
+    void VisibilitySweep::prepare(const Point& center, double radius, std::size_t source) {
+        center_ = center;
+        radius_ = radius;
+        direct_.clear();
+        swept_.assign(disks_.size(), false);
+        reach_.resize(disks_.size());
+        start_ray_.resize(disks_.size());
+
+        for (std::uint32_t k = 0; k < disks_.size(); ++k) {
+            if (k == source) {
+                continue;
+            }
+            const Disk& disk = disks_[k];
+            double dx = disk.center.x - center.x;
+            double dy = disk.center.y - center.y;
+            double d = std::sqrt(dx * dx + dy * dy);
+            if (d <= radius + disk.radius) {
+                direct_.push_back(k); // overlaps the source, hit from inside by some rays
+                continue;
+            }
+            swept_[k] = true;
+            double cos_near = (radius + disk.radius) / d;
+            double cos_far = (radius - disk.radius) / d;
+            reach_[k] = {std::atan2(dy, dx), std::acos(cos_near), std::acos(cos_far),
+                         {dx / d, dy / d},
+                         {cos_near, std::sqrt(1.0 - cos_near * cos_near)},
+                         {cos_far, std::sqrt(1.0 - cos_far * cos_far)}};
+        }
+    }
+
+    void VisibilitySweep::sweep(double orientation, std::vector<bool>& visible) {
+        orientation_ = orientation;
+        events_.clear();
+        query_angles_.clear();
+        active_.clear();
+        position_.assign(disks_.size(), active_.end());
+
+        for (std::uint32_t i = 0; i < segments_.size(); ++i) {
+            const Segment& segment = segments_[i];
+            if (segment.clockwise != (orientation < 0.0)) {
+                continue;
+            }
+            double angle = radius_ > 0.0
+                               ? std::atan2(segment.from.y - center_.y, segment.from.x - center_.x)
+                               : ray_angle(segment.to);
+            events_.push_back({normalize(angle), EventKind::Query, i});
+            query_angles_.push_back(events_.back().angle);
+        }
+        if (events_.empty()) {
+            return;
+        }
+        std::sort(query_angles_.begin(), query_angles_.end());
+        auto holds_query = [&](double from, double to) {
+            auto it = std::lower_bound(query_angles_.begin(), query_angles_.end(), from);
+            return it != query_angles_.end() && *it <= to;
+        };
+
+        reached_.assign(disks_.size(), false);
+        for (std::uint32_t k = 0; k < disks_.size(); ++k) {
+            if (!swept_[k]) {
+                continue;
+            }
+            // Counter-clockwise rays reach the disk from toward - far to
+            // toward - near, clockwise ones from toward + near to toward + far
+            const Reach& reach = reach_[k];
+            double start = normalize((orientation > 0.0 ? reach.toward - reach.far : reach.toward + reach.near) -
+                                     ANGLE_EPSILON);
+            double end = start + (reach.far - reach.near) + 2.0 * ANGLE_EPSILON;
+            bool wraps = end >= PI;
+            if (!holds_query(start, end) && !(wraps && holds_query(-PI, end - TWO_PI))) {
+                continue; // no segment passes this disk
+            }
+            reached_[k] = true;
+
+            const Point& t = reach.toward_direction;
+            if (orientation > 0.0) {
+                start_ray_[k] = {t.x * reach.far_direction.x + t.y * reach.far_direction.y,
+                                 t.y * reach.far_direction.x - t.x * reach.far_direction.y};
+            } else {
+                start_ray_[k] = {t.x * reach.near_direction.x - t.y * reach.near_direction.y,
+                                 t.y * reach.near_direction.x + t.x * reach.near_direction.y};
+            }
+            if (wraps) {
+                // Crosses the start of the sweep: active from -pi, then again from start
+                events_.push_back({-PI, EventKind::Insert, k});
+                events_.push_back({end - TWO_PI, EventKind::Remove, k});
+            } else {
+                events_.push_back({end, EventKind::Remove, k});
+            }
+            events_.push_back({start, EventKind::Insert, k});
+        }
+
+        // Two overlapping disks swap places where a ray enters both at one of
+        // their crossings
+        for (std::uint32_t c = 0; c < crossings_.size(); ++c) {
+            const Crossing& crossing = crossings_[c];
+            if (!reached_[crossing.first] || !reached_[crossing.second]) {
+                continue;
+            }
+            // Direction of the ray through the crossing: away from its tangent point
+            double qx = crossing.point.x - center_.x;
+            double qy = crossing.point.y - center_.y;
+            double q2 = qx * qx + qy * qy;
+            double tangent = std::sqrt(std::max(0.0, q2 - radius_ * radius_));
+            double dx = qx - radius_ * (qx * radius_ + orientation * qy * tangent) / q2;
+            double dy = qy - radius_ * (qy * radius_ - orientation * qx * tangent) / q2;
+            auto enters = [&](std::uint32_t k) {
+                return (crossing.point.x - disks_[k].center.x) * dx +
+                       (crossing.point.y - disks_[k].center.y) * dy < 0.0;
+            };
+            if (enters(crossing.first) && enters(crossing.second)) {
+                events_.push_back({ray_angle(crossing.point), EventKind::Swap, c});
+            }
+        }
+
+        std::sort(events_.begin(), events_.end(), [](const Event& a, const Event& b) {
+            return a.angle != b.angle ? a.angle < b.angle : a.kind < b.kind;
+        });
+
+        for (const auto& event : events_) {
+            switch (event.kind) {
+                case EventKind::Insert:
+                    if (event.angle == -PI) {
+                        set_ray(-1.0, 0.0);
+                    } else {
+                        set_ray(start_ray_[event.index].x, start_ray_[event.index].y);
+                    }
+                    insert(event.index);
+                    break;
+                case EventKind::Remove:
+                    active_.erase(position_[event.index]);
+                    position_[event.index] = active_.end();
+                    break;
+                case EventKind::Swap: {
+                    std::uint32_t a = crossings_[event.index].first;
+                    std::uint32_t b = crossings_[event.index].second;
+                    if (position_[a] == active_.end() || position_[b] == active_.end()) {
+                        break;
+                    }
+                    // Just past the crossing the two disks are strictly ordered again
+                    active_.erase(position_[a]);
+                    active_.erase(position_[b]);
+                    set_ray(std::cos(event.angle + ANGLE_EPSILON), std::sin(event.angle + ANGLE_EPSILON));
+                    insert(a);
+                    insert(b);
+                    break;
+                }
+                case EventKind::Query: {
+                    const Segment& segment = segments_[event.index];
+                    double length = segment.from.distance(segment.to);
+                    if (radius_ > 0.0) {
+                        set_ray((segment.from.x - center_.x) / radius_, (segment.from.y - center_.y) / radius_);
+                    } else {
+                        set_ray((segment.to.y - segment.from.y) / length, (segment.from.x - segment.to.x) / length);
+                    }
+                    double limit = length + 1e-9 * (1.0 + length);
+                    bool blocked = false;
+                    for (std::uint32_t k : active_) {
+                        if (entry(k) >= limit) {
+                            break; // every remaining disk is entered beyond the segment's end
+                        }
+                        if (k != segment.disk && blocks(disks_[k], segment.from, segment.to)) {
+                            blocked = true;
+                            break;
+                        }
+                    }
+                    for (std::size_t n = 0; n < direct_.size() && !blocked; ++n) {
+                        std::uint32_t k = direct_[n];
+                        blocked = k != segment.disk && blocks(disks_[k], segment.from, segment.to);
+                    }
+                    visible[segment.index] = !blocked;
+                    break;
+                }
+            }
+        }
+    }
+
+    void VisibilitySweep::set_ray(double cos_angle, double sin_angle) {
+        ray_origin_ = {center_.x + radius_ * cos_angle, center_.y + radius_ * sin_angle};
+        ray_direction_ = {-orientation_ * sin_angle, orientation_ * cos_angle};
+    }
+
+    double VisibilitySweep::ray_angle(const Point& p) const {
+        // p lies on the ray whose tangent point is seen from the center at
+        // atan(tangent length / radius) behind p's direction
+        double dx = p.x - center_.x;
+        double dy = p.y - center_.y;
+        double tangent = std::sqrt(std::max(0.0, dx * dx + dy * dy - radius_ * radius_));
+        return normalize(std::atan2(dy, dx) - orientation_ * std::atan2(tangent, radius_));
+    }
+
+    double VisibilitySweep::entry(std::uint32_t disk) const {
+        const Disk& d = disks_[disk];
+        double wx = d.center.x - ray_origin_.x;
+        double wy = d.center.y - ray_origin_.y;
+        double along = wx * ray_direction_.x + wy * ray_direction_.y;
+        double across = wx * wx + wy * wy - along * along;
+        // A ray just missing the disk (inside the angular slack) counts its closest approach
+        return along - std::sqrt(std::max(0.0, d.radius * d.radius - across));
+    }
+
+    bool VisibilitySweep::is_covered(const Point& p, std::size_t skip_first, std::size_t skip_second) const {
+        bool covered = false;
+        index_.for_each_candidate(p, p, [&](std::size_t k) {
+            const Disk& disk = disks_[k];
+            covered = covered || (k != skip_first && k != skip_second &&
+                                  disk.center.distance(p) < disk.radius - 1e-9 * (1.0 + disk.radius));
+        });
+        return covered;
+    }
+
+    void VisibilitySweep::insert(std::uint32_t disk) {
+        position_[disk] = active_.insert(disk).first;
+    }
+
+} // namespace geometry
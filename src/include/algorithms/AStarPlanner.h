@@ -0,0 +1,73 @@
+#ifndef ALGORITHMS_A_STAR_PLANNER_H
+#define ALGORITHMS_A_STAR_PLANNER_H
+
+#include "GraphPlanner.h"
+#include "AStarSearch.h"
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+    /**
+     * A* over the graph of any GraphBuilder. Heuristic is one of
+     * EuclideanHeuristic, OctileHeuristic or ZeroHeuristic (Dijkstra).
+     */
+    template <typename Heuristic = EuclideanHeuristic>
+    class AStarPlanner : public GraphPlanner {
+    public:
+        AStarPlanner(std::shared_ptr<graph::GraphBuilder> builder, NodeLocator locator)
+            : GraphPlanner(std::move(builder), std::move(locator)) {}
+
+        [[nodiscard]] PathResult find_path(const geometry::Scene& scene) override {
+            const SearchGraph& search_graph = prepare(scene);
+            auto start = locate(scene.start);
+            auto goal = locate(scene.goal);
+            if (!start || !goal) {
+                return std::nullopt;
+            }
+
+            PF_SCOPED_TIMER("astar.search");
+            auto node_point = [&search_graph](graph::NodeId u) { return search_graph.points[u]; };
+            if (!search_.search(search_graph.graph, node_point, *start, *goal)) {
+                return std::nullopt;
+            }
+            return make_path(scene.start, scene.goal, search_.path());
+        }
+
+        /**
+         * Builds the graph once and answers the queries in parallel, each
+         * thread with its own search buffers. Builders whose graph depends on
+         * the endpoints build it for every query instead.
+         */
+        [[nodiscard]] BatchResult plan_batch(const geometry::Scene& scene, std::span<const Query> queries) override {
+            auto node_point = [this](graph::NodeId u) { return search_graph_.points[u]; };
+            return plan_shared_batch(
+                scene, queries,
+                [&](unsigned workers) {
+                    prepare(scene);
+                    batch_searches_.resize(workers);
+                },
+                [&](unsigned worker, graph::NodeId start, graph::NodeId goal) -> std::optional<std::vector<graph::NodeId>> {
+                    AStarSearch<Heuristic>& search = batch_searches_[worker];
+                    PF_SCOPED_TIMER("astar.search");
+                    if (!search.search(search_graph_.graph, node_point, start, goal)) {
+                        return std::nullopt;
+                    }
+                    return search.path();
+                });
+        }
+
+        [[nodiscard]] std::string name() const override {
+            return "A* (" + Heuristic::name() + ")";
+        }
+
+    private:
+        AStarSearch<Heuristic> search_;
+        std::vector<AStarSearch<Heuristic>> batch_searches_;
+    };
+
+}
+
+#endif
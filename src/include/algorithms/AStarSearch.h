@@ -0,0 +1,126 @@
+#ifndef ALGORITHMS_A_STAR_SEARCH_H
+#define ALGORITHMS_A_STAR_SEARCH_H
+
+#include "CsrGraph.h"
+#include "DaryHeap.h"
+#include "Heuristics.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace algorithms {
+
+    /**
+     * A* over any graph exposing node_count() and for_each_neighbor(u, fn)
+     * (CsrGraph, ImplicitGridGraph). The heuristic is a compile-time parameter.
+     *
+     * The per-node buffers are kept between queries and invalidated with a
+     * generation stamp, so a new query costs nothing proportional to the graph size.
+     */
+    template <typename Heuristic = EuclideanHeuristic>
+    class AStarSearch {
+    public:
+        explicit AStarSearch(Heuristic heuristic = {}) : heuristic_(heuristic) {}
+
+        /**
+         * @param node_point callable NodeId -> geometry::Point used by the heuristic
+         * @return true if goal is reachable from start
+         */
+        template <typename GraphT, typename PointFn>
+        bool search(const GraphT& graph, PointFn&& node_point, graph::NodeId start, graph::NodeId goal) {
+            begin_query(graph.node_count());
+            start_ = start;
+            goal_ = goal;
+            expanded_ = 0;
+
+            const geometry::Point goal_point = node_point(goal);
+            open_.clear();
+            touch(start, 0.0, graph::INVALID_NODE);
+            open_.push(heuristic_(node_point(start), goal_point), start);
+
+            while (!open_.empty()) {
+                graph::NodeId u = open_.top().node;
+                open_.pop();
+                if (closed_[u] == generation_) {
+                    continue; // outdated entry
+                }
+                closed_[u] = generation_;
+                ++expanded_;
+                PF_COUNT(nodes_expanded, 1);
+
+                if (u == goal) {
+                    return true;
+                }
+
+                const double g_u = g_[u];
+                graph.for_each_neighbor(u, [&](graph::NodeId v, double weight) {
+                    if (closed_[v] == generation_) {
+                        return;
+                    }
+                    double g_v = g_u + weight;
+                    if (seen_[v] == generation_ && g_v >= g_[v]) {
+                        return;
+                    }
+                    touch(v, g_v, u);
+                    PF_COUNT(edges_relaxed, 1);
+                    open_.push(g_v + heuristic_(node_point(v), goal_point), v);
+                });
+            }
+            return false;
+        }
+
+        /**
+         * Nodes from start to goal of the last successful search
+         */
+        [[nodiscard]] std::vector<graph::NodeId> path() const {
+            std::vector<graph::NodeId> nodes;
+            for (graph::NodeId u = goal_; u != graph::INVALID_NODE; u = parent_[u]) {
+                nodes.push_back(u);
+            }
+            std::reverse(nodes.begin(), nodes.end());
+            return nodes;
+        }
+
+        [[nodiscard]] double cost() const { return g_[goal_]; }
+        [[nodiscard]] std::size_t expanded() const { return expanded_; }
+
+    private:
+        Heuristic heuristic_;
+        DaryHeap<double> open_;
+
+        std::vector<double> g_;
+        std::vector<graph::NodeId> parent_;
+        std::vector<std::uint32_t> seen_;
+        std::vector<std::uint32_t> closed_;
+        std::uint32_t generation_ = 0;
+
+        graph::NodeId start_ = graph::INVALID_NODE;
+        graph::NodeId goal_ = graph::INVALID_NODE;
+        std::size_t expanded_ = 0;
+
+        void begin_query(std::size_t node_count) {
+            if (g_.size() < node_count) {
+                PF_COUNT(bytes_allocated, (node_count - g_.size()) *
+                         (sizeof(double) + sizeof(graph::NodeId) + 2 * sizeof(std::uint32_t)));
+                g_.resize(node_count);
+                parent_.resize(node_count);
+                seen_.resize(node_count, 0);
+                closed_.resize(node_count, 0);
+            }
+            if (++generation_ == 0) {
+                std::fill(seen_.begin(), seen_.end(), 0);
+                std::fill(closed_.begin(), closed_.end(), 0);
+                generation_ = 1;
+            }
+        }
+
+        void touch(graph::NodeId u, double g, graph::NodeId parent) {
+            seen_[u] = generation_;
+            g_[u] = g;
+            parent_[u] = parent;
+        }
+    };
+
+}
+
+#endif
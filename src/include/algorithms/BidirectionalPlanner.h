@@ -0,0 +1,99 @@
+#ifndef ALGORITHMS_BIDIRECTIONAL_PLANNER_H
+#define ALGORITHMS_BIDIRECTIONAL_PLANNER_H
+
+#include "GraphPlanner.h"
+#include "BidirectionalSearch.h"
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+    /**
+     * Bidirectional A* over the graph of any GraphBuilder, meeting in the
+     * middle between scene start and goal. Heuristic is one of
+     * EuclideanHeuristic, OctileHeuristic or ZeroHeuristic (bidirectional Dijkstra).
+     * Graphs of builders that are not symmetric are searched backwards over
+     * their transpose.
+     */
+    template <typename Heuristic = EuclideanHeuristic>
+    class BidirectionalPlanner : public GraphPlanner {
+    public:
+        BidirectionalPlanner(std::shared_ptr<graph::GraphBuilder> builder, NodeLocator locator)
+            : GraphPlanner(std::move(builder), std::move(locator)) {}
+
+        [[nodiscard]] PathResult find_path(const geometry::Scene& scene) override {
+            const SearchGraph& search_graph = prepare_both(scene);
+            auto start = locate(scene.start);
+            auto goal = locate(scene.goal);
+            if (!start || !goal) {
+                return std::nullopt;
+            }
+
+            PF_SCOPED_TIMER("bidirectional.search");
+            auto node_point = [&search_graph](graph::NodeId u) { return search_graph.points[u]; };
+            if (!search_.search(search_graph.graph, reverse_graph(), node_point, *start, *goal)) {
+                return std::nullopt;
+            }
+            return make_path(scene.start, scene.goal, search_.path());
+        }
+
+        /**
+         * Builds the graph once and answers the queries in parallel, each
+         * thread with its own search buffers. Builders whose graph depends on
+         * the endpoints build it for every query instead.
+         */
+        [[nodiscard]] BatchResult plan_batch(const geometry::Scene& scene, std::span<const Query> queries) override {
+            auto node_point = [this](graph::NodeId u) { return search_graph_.points[u]; };
+            return plan_shared_batch(
+                scene, queries,
+                [&](unsigned workers) {
+                    prepare_both(scene);
+                    batch_searches_.resize(workers);
+                },
+                [&](unsigned worker, graph::NodeId start, graph::NodeId goal) -> std::optional<std::vector<graph::NodeId>> {
+                    BidirectionalSearch<Heuristic>& search = batch_searches_[worker];
+                    PF_SCOPED_TIMER("bidirectional.search");
+                    if (!search.search(search_graph_.graph, reverse_graph(), node_point, start, goal)) {
+                        return std::nullopt;
+                    }
+                    return search.path();
+                });
+        }
+
+        [[nodiscard]] std::string name() const override {
+            return "Bidirectional A* (" + Heuristic::name() + ")";
+        }
+
+        /**
+         * Nodes expanded by both frontiers in the last find_path
+         */
+        [[nodiscard]] std::size_t expanded() const { return search_.expanded(); }
+
+    private:
+        BidirectionalSearch<Heuristic> search_;
+        graph::CsrGraph reverse_;
+        bool symmetric_ = true;
+        std::vector<BidirectionalSearch<Heuristic>> batch_searches_;
+
+        const SearchGraph& prepare_both(const geometry::Scene& scene) {
+            const SearchGraph& search_graph = prepare(scene);
+            symmetric_ = builder_->is_symmetric();
+            if (!symmetric_) {
+                PF_SCOPED_TIMER("bidirectional.transpose");
+                reverse_ = search_graph.graph.transposed();
+            } else {
+                reverse_.clear();
+            }
+            return search_graph;
+        }
+
+        [[nodiscard]] const graph::CsrGraph& reverse_graph() const {
+            return symmetric_ ? search_graph_.graph : reverse_;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,192 @@
+#ifndef ALGORITHMS_BIDIRECTIONAL_SEARCH_H
+#define ALGORITHMS_BIDIRECTIONAL_SEARCH_H
+
+#include "CsrGraph.h"
+#include "DaryHeap.h"
+#include "Heuristics.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace algorithms {
+
+    /**
+     * Bidirectional A* over a CsrGraph (NBA*, Pijls and Post): one frontier
+     * grows from start over the graph, the other from goal over its reverse,
+     * each guided by its own heuristic. A settled node is only expanded if it
+     * can still improve the best meeting cost L found so far, judged by its
+     * own f and by the smallest f on the opposite side; the search stops once
+     * either side's smallest f reaches L. Costs are optimal for a consistent
+     * heuristic; with ZeroHeuristic this is bidirectional Dijkstra.
+     *
+     * Buffers are kept between queries and invalidated with a generation stamp,
+     * as in AStarSearch.
+     */
+    template <typename Heuristic = EuclideanHeuristic>
+    class BidirectionalSearch {
+    public:
+        explicit BidirectionalSearch(Heuristic heuristic = {}) : heuristic_(heuristic) {}
+
+        /**
+         * @param reverse graph with every edge reversed; the graph itself if it is symmetric
+         * @param node_point callable NodeId -> geometry::Point used by the heuristic
+         * @return true if goal is reachable from start
+         */
+        template <typename PointFn>
+        bool search(const graph::CsrGraph& graph, const graph::CsrGraph& reverse, PointFn&& node_point,
+                    graph::NodeId start, graph::NodeId goal) {
+            begin_query(graph.node_count());
+            expanded_ = 0;
+            meet_forward_ = graph::INVALID_NODE;
+            meet_backward_ = graph::INVALID_NODE;
+            best_ = std::numeric_limits<double>::infinity();
+
+            Side& forward = sides_[0];
+            Side& backward = sides_[1];
+            forward.open.clear();
+            backward.open.clear();
+            // Forward estimates the distance to goal, backward the distance from start
+            const geometry::Point start_point = node_point(start);
+            const geometry::Point goal_point = node_point(goal);
+            auto to_goal = [&](graph::NodeId u) { return heuristic_(node_point(u), goal_point); };
+            auto from_start = [&](graph::NodeId u) { return heuristic_(start_point, node_point(u)); };
+
+            touch(forward, start, 0.0, graph::INVALID_NODE);
+            touch(backward, goal, 0.0, graph::INVALID_NODE);
+            forward.open.push(to_goal(start), start);
+            backward.open.push(from_start(goal), goal);
+            if (start == goal) {
+                meet_forward_ = start;
+                meet_backward_ = goal;
+                best_ = 0.0;
+            }
+
+            while (!forward.open.empty() && !backward.open.empty()) {
+                if (forward.open.top().key >= best_ || backward.open.top().key >= best_) {
+                    break;
+                }
+                // Grow the smaller frontier; on open scenes this keeps the two balanced
+                if (forward.open.size() <= backward.open.size()) {
+                    expand(graph, forward, backward, to_goal, from_start, true);
+                } else {
+                    expand(reverse, backward, forward, from_start, to_goal, false);
+                }
+            }
+            return meet_forward_ != graph::INVALID_NODE;
+        }
+
+        /**
+         * Nodes from start to goal of the last successful search
+         */
+        [[nodiscard]] std::vector<graph::NodeId> path() const {
+            std::vector<graph::NodeId> nodes;
+            for (graph::NodeId u = meet_forward_; u != graph::INVALID_NODE; u = sides_[0].parent[u]) {
+                nodes.push_back(u);
+            }
+            std::reverse(nodes.begin(), nodes.end());
+            if (meet_backward_ != graph::INVALID_NODE) {
+                graph::NodeId u = meet_backward_ == meet_forward_ ? sides_[1].parent[meet_backward_] : meet_backward_;
+                for (; u != graph::INVALID_NODE; u = sides_[1].parent[u]) {
+                    nodes.push_back(u);
+                }
+            }
+            return nodes;
+        }
+
+        [[nodiscard]] double cost() const { return best_; }
+        [[nodiscard]] std::size_t expanded() const { return expanded_; }
+
+    private:
+        struct Side {
+            DaryHeap<double> open;
+            std::vector<double> g;
+            std::vector<graph::NodeId> parent;
+            std::vector<std::uint32_t> seen;
+            std::vector<std::uint32_t> closed;
+        };
+
+        Heuristic heuristic_;
+        Side sides_[2];
+        std::uint32_t generation_ = 0;
+
+        // Best path found so far runs start ~> meet_forward_ -> meet_backward_ ~> goal
+        graph::NodeId meet_forward_ = graph::INVALID_NODE;
+        graph::NodeId meet_backward_ = graph::INVALID_NODE;
+        double best_ = 0.0;
+        std::size_t expanded_ = 0;
+
+        /**
+         * Settles the top node of side. own estimates the remaining distance
+         * of side, opposite that of the other side.
+         */
+        template <typename OwnFn, typename OppositeFn>
+        void expand(const graph::CsrGraph& graph, Side& side, const Side& other,
+                    OwnFn& own, OppositeFn& opposite, bool is_forward) {
+            const double f_u = side.open.top().key;
+            graph::NodeId u = side.open.top().node;
+            side.open.pop();
+            if (side.closed[u] == generation_) {
+                return; // outdated entry
+            }
+            side.closed[u] = generation_;
+            // Nodes the other side settled are already covered by L
+            if (other.closed[u] == generation_) {
+                return;
+            }
+            const double g_u = side.g[u];
+            if (f_u >= best_ || g_u + other.open.top().key - opposite(u) >= best_) {
+                return; // cannot lie on a path shorter than L
+            }
+            ++expanded_;
+            PF_COUNT(nodes_expanded, 1);
+
+            graph.for_each_neighbor(u, [&](graph::NodeId v, double weight) {
+                if (side.closed[v] == generation_ || other.closed[v] == generation_) {
+                    return;
+                }
+                double g_v = g_u + weight;
+                if (side.seen[v] == generation_ && g_v >= side.g[v]) {
+                    return;
+                }
+                touch(side, v, g_v, u);
+                PF_COUNT(edges_relaxed, 1);
+                side.open.push(g_v + own(v), v);
+                if (other.seen[v] == generation_ && g_v + other.g[v] < best_) {
+                    best_ = g_v + other.g[v];
+                    meet_forward_ = is_forward ? u : v;
+                    meet_backward_ = is_forward ? v : u;
+                }
+            });
+        }
+
+        void begin_query(std::size_t node_count) {
+            for (Side& side : sides_) {
+                if (side.g.size() < node_count) {
+                    PF_COUNT(bytes_allocated, (node_count - side.g.size()) *
+                             (sizeof(double) + sizeof(graph::NodeId) + 2 * sizeof(std::uint32_t)));
+                    side.g.resize(node_count);
+                    side.parent.resize(node_count);
+                    side.seen.resize(node_count, 0);
+                    side.closed.resize(node_count, 0);
+                }
+            }
+            if (++generation_ == 0) {
+                for (Side& side : sides_) {
+                    std::fill(side.seen.begin(), side.seen.end(), 0);
+                    std::fill(side.closed.begin(), side.closed.end(), 0);
+                }
+                generation_ = 1;
+            }
+        }
+
+        void touch(Side& side, graph::NodeId u, double g, graph::NodeId parent) {
+            side.seen[u] = generation_;
+            side.g[u] = g;
+            side.parent[u] = parent;
+        }
+    };
+
+}
+
+#endif
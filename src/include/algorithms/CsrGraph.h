@@ -0,0 +1,77 @@
+#ifndef ALGORITHMS_GRAPH_CSR_GRAPH_H
+#define ALGORITHMS_GRAPH_CSR_GRAPH_H
+
+#include "Graph.h"
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace algorithms::graph {
+
+    using NodeId = std::uint32_t;
+
+    /**
+     * Sentinel for "no node", e.g. a blocked cell in a dense cell -> node table
+     */
+    inline constexpr NodeId INVALID_NODE = std::numeric_limits<NodeId>::max();
+
+    /**
+     * Compressed sparse row graph: the edges of node u are
+     * targets[offsets[u] .. offsets[u + 1]) with matching weights.
+     * All edges live in two contiguous arrays instead of one vector per node.
+     */
+    struct CsrGraph {
+        std::vector<std::uint32_t> offsets{0};
+        std::vector<NodeId> targets;
+        std::vector<double> weights;
+
+        [[nodiscard]] std::size_t node_count() const { return offsets.size() - 1; }
+        [[nodiscard]] std::size_t edge_count() const { return targets.size(); }
+
+        [[nodiscard]] std::size_t degree(NodeId u) const {
+            return offsets[u + 1] - offsets[u];
+        }
+
+        [[nodiscard]] std::span<const NodeId> neighbors(NodeId u) const {
+            return {targets.data() + offsets[u], degree(u)};
+        }
+
+        [[nodiscard]] std::span<const double> edge_weights(NodeId u) const {
+            return {weights.data() + offsets[u], degree(u)};
+        }
+
+        /**
+         * Calls fn(neighbour, weight) for every edge of u
+         */
+        template <typename Fn>
+        void for_each_neighbor(NodeId u, Fn&& fn) const {
+            for (std::uint32_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+                fn(targets[e], weights[e]);
+            }
+        }
+
+        [[nodiscard]] std::size_t memory_bytes() const {
+            return offsets.capacity() * sizeof(std::uint32_t) +
+                   targets.capacity() * sizeof(NodeId) +
+                   weights.capacity() * sizeof(double);
+        }
+
+        void clear() {
+            offsets.assign(1, 0);
+            targets.clear();
+            weights.clear();
+        }
+
+        [[nodiscard]] static CsrGraph from_adjacency(const Graph& graph);
+        [[nodiscard]] Graph to_adjacency() const;
+
+        /**
+         * Same nodes with every edge u -> v turned into v -> u
+         */
+        [[nodiscard]] CsrGraph transposed() const;
+    };
+
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef ALGORITHMS_D_STAR_LITE_PLANNER_H
+#define ALGORITHMS_D_STAR_LITE_PLANNER_H
+
+#include "GraphPlanner.h"
+#include "DaryHeap.h"
+#include "Heuristics.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+    /**
+     * D* Lite replanner. The search runs backwards from the goal and its state
+     * (g, rhs, open list) survives between find_path calls.
+     *
+     * Each call diffs the scene obstacles against the previous call by
+     * Disk::id, hands the changes to GraphBuilder::update and repairs only the
+     * nodes whose edges changed. The start may move freely; a new goal, or a
+     * builder that had to rebuild its graph, restarts the search.
+     * The builder's graph must be symmetric: the backward search uses each
+     * node's edges as its predecessors.
+     */
+    class DStarLitePlanner : public GraphPlanner {
+    public:
+        DStarLitePlanner(std::shared_ptr<graph::GraphBuilder> builder, NodeLocator locator);
+
+        [[nodiscard]] PathResult find_path(const geometry::Scene& scene) override;
+        [[nodiscard]] std::string name() const override;
+
+        /**
+         * Forgets the graph and the search state; the next call starts from scratch
+         */
+        void reset();
+
+        /**
+         * Nodes expanded by the last query
+         */
+        [[nodiscard]] std::size_t expanded() const { return expanded_; }
+
+    private:
+        using Key = std::pair<double, double>;
+
+        enum class Descent {
+            Found,
+            NoPath,
+            Stale // stepped on an inconsistent node
+        };
+
+        // Graph and scene of the previous call
+        graph::Graph graph_;
+        std::vector<geometry::Disk> obstacles_;
+        geometry::Scene last_scene_;
+        bool has_graph_ = false;
+
+        std::vector<double> g_;
+        std::vector<double> rhs_;
+        std::vector<Key> queued_key_;
+        std::vector<std::uint8_t> queued_;
+        DaryHeap<Key> open_;
+        graph::NodeId start_ = graph::INVALID_NODE;
+        graph::NodeId goal_ = graph::INVALID_NODE;
+        double key_modifier_ = 0.0;
+        std::size_t expanded_ = 0;
+        EuclideanHeuristic heuristic_;
+
+        void sync_nodes();
+        void restart_search(graph::NodeId goal);
+
+        [[nodiscard]] Key calculate_key(graph::NodeId u) const;
+        [[nodiscard]] double best_successor_cost(graph::NodeId u) const;
+        void update_vertex(graph::NodeId u);
+        void compute_shortest_path();
+        [[nodiscard]] Descent extract_path(std::vector<graph::NodeId>& nodes) const;
+    };
+
+}
+
+#endif
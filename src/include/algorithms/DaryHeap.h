@@ -0,0 +1,89 @@
+#ifndef ALGORITHMS_DARY_HEAP_H
+#define ALGORITHMS_DARY_HEAP_H
+
+#include "CsrGraph.h"
+#include "Instrumentation.h"
+#include <cstddef>
+#include <vector>
+
+namespace algorithms {
+
+    /**
+     * Array-backed d-ary min-heap of (key, node) entries.
+     * There is no decrease-key: searches push a node again with the better key
+     * and skip outdated entries when they are popped.
+     */
+    template <typename Key, unsigned Arity = 4>
+    class DaryHeap {
+    public:
+        struct Entry {
+            Key key;
+            graph::NodeId node;
+        };
+
+        [[nodiscard]] bool empty() const { return entries_.empty(); }
+        [[nodiscard]] std::size_t size() const { return entries_.size(); }
+        [[nodiscard]] const Entry& top() const { return entries_.front(); }
+
+        void reserve(std::size_t capacity) { entries_.reserve(capacity); }
+        void clear() { entries_.clear(); }
+
+        void push(const Key& key, graph::NodeId node) {
+            PF_COUNT(heap_pushes, 1);
+            entries_.push_back({key, node});
+            sift_up(entries_.size() - 1);
+        }
+
+        void pop() {
+            PF_COUNT(heap_pops, 1);
+            entries_.front() = entries_.back();
+            entries_.pop_back();
+            if (!entries_.empty()) {
+                sift_down(0);
+            }
+        }
+
+    private:
+        std::vector<Entry> entries_;
+
+        void sift_up(std::size_t i) {
+            Entry entry = entries_[i];
+            while (i > 0) {
+                std::size_t parent = (i - 1) / Arity;
+                if (!(entry.key < entries_[parent].key)) {
+                    break;
+                }
+                entries_[i] = entries_[parent];
+                i = parent;
+            }
+            entries_[i] = entry;
+        }
+
+        void sift_down(std::size_t i) {
+            Entry entry = entries_[i];
+            const std::size_t count = entries_.size();
+            while (true) {
+                std::size_t first_child = i * Arity + 1;
+                if (first_child >= count) {
+                    break;
+                }
+                std::size_t last_child = first_child + Arity < count ? first_child + Arity : count;
+                std::size_t best = first_child;
+                for (std::size_t c = first_child + 1; c < last_child; ++c) {
+                    if (entries_[c].key < entries_[best].key) {
+                        best = c;
+                    }
+                }
+                if (!(entries_[best].key < entry.key)) {
+                    break;
+                }
+                entries_[i] = entries_[best];
+                i = best;
+            }
+            entries_[i] = entry;
+        }
+    };
+
+}
+
+#endif
@@ -13,6 +13,17 @@ namespace algorithms::graph {
         };
 
         std::vector<std::vector<Edge>> adj;
+
+        /**
+         * Bytes held by the adjacency lists, capacity included
+         */
+        [[nodiscard]] std::size_t memory_bytes() const {
+            std::size_t bytes = adj.capacity() * sizeof(std::vector<Edge>);
+            for (const auto& edges : adj) {
+                bytes += edges.capacity() * sizeof(Edge);
+            }
+            return bytes;
+        }
     };
 
 }
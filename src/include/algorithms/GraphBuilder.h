@@ -2,8 +2,12 @@
 #define ALGORITHMS_GRAPH_GRAPH_BUILDER_H
 
 #include "../geometry/Scene.h"
+#include "../geometry/ObstacleDelta.h"
 #include "Graph.h"
+#include <numeric>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace algorithms::graph {
 
@@ -13,6 +17,41 @@ namespace algorithms::graph {
 
         [[nodiscard]] virtual Graph build(const geometry::Scene& scene) = 0;
         [[nodiscard]] virtual std::string name() const = 0;
+
+        /**
+         * Brings graph, the result of the last build(), up to date with obstacle
+         * deltas already applied to scene. Returns the nodes whose adjacency
+         * changed; nodes that appear get the next free ids, nodes that are no
+         * longer reachable keep theirs with no edges.
+         * The default rebuilds from scratch and reports every node.
+         */
+        virtual std::vector<std::size_t> update(const geometry::Scene& scene,
+                                                std::span<const geometry::ObstacleDelta> /*deltas*/,
+                                                Graph& graph) {
+            graph = build(scene);
+            std::vector<std::size_t> nodes(graph.adj.size());
+            std::iota(nodes.begin(), nodes.end(), std::size_t{0});
+            return nodes;
+        }
+
+        /**
+         * Appends the points strictly between adjacent nodes from and to of the
+         * last built graph. Edges are straight segments unless a builder says otherwise.
+         */
+        virtual void append_edge_path(std::size_t /*from*/, std::size_t /*to*/,
+                                      std::vector<geometry::Point>& /*points*/) const {}
+
+        /**
+         * True if every edge u -> v of the built graph comes with v -> u of the
+         * same weight, so backward searches can walk the graph as it is
+         */
+        [[nodiscard]] virtual bool is_symmetric() const { return false; }
+
+        /**
+         * True if the graph is built around the scene's start and goal, so it
+         * cannot answer queries between other points
+         */
+        [[nodiscard]] virtual bool depends_on_endpoints() const { return false; }
     };
 
 }
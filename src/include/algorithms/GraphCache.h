@@ -0,0 +1,60 @@
+#ifndef ALGORITHMS_GRAPH_CACHE_H
+#define ALGORITHMS_GRAPH_CACHE_H
+
+#include "GraphPlanner.h"
+#include "GridGraphBuilder.h"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace algorithms {
+
+    /**
+     * On-disk cache of built graphs, one binary file per key in a directory.
+     *
+     * A file holds the CSR arrays and the node points of a SearchGraph behind
+     * a small header (magic, version, key, node and edge counts), each array
+     * 8-byte aligned so the file is read through a read-only mapping.
+     * Unreadable, stale or corrupt files count as misses.
+     */
+    class GraphCache {
+    public:
+        // Bumped whenever the file layout or what a builder produces changes
+        static constexpr std::uint32_t VERSION = 1;
+
+        explicit GraphCache(std::filesystem::path directory);
+
+        /**
+         * Content hash of the obstacles and the scene bounds plus the builder
+         * name and the parameters that change its graph. Start and goal are not
+         * hashed; builders whose graph depends on them pass them as parameters.
+         */
+        [[nodiscard]] static std::uint64_t key(const geometry::Scene& scene, std::string_view builder,
+                                               std::span<const double> parameters);
+
+        /**
+         * Key of the graph builder.build_csr(scene) produces (grid step, diagonals)
+         */
+        [[nodiscard]] static std::uint64_t key(const geometry::Scene& scene, const graph::GridGraphBuilder& builder);
+
+        [[nodiscard]] std::optional<SearchGraph> load(std::uint64_t key) const;
+
+        /**
+         * Writes a temporary file and renames it over the entry, so concurrent
+         * readers never see a partial file
+         * @return false if the file could not be written
+         */
+        bool store(std::uint64_t key, const SearchGraph& graph) const;
+
+        [[nodiscard]] std::filesystem::path file_path(std::uint64_t key) const;
+        [[nodiscard]] const std::filesystem::path& get_directory() const { return directory_; }
+
+    private:
+        std::filesystem::path directory_;
+    };
+
+}
+
+#endif
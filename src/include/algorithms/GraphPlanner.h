@@ -0,0 +1,155 @@
+#ifndef ALGORITHMS_GRAPH_PLANNER_H
+#define ALGORITHMS_GRAPH_PLANNER_H
+
+#include "Planner.h"
+#include "GraphBuilder.h"
+#include "CsrGraph.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+    class GraphCache;
+
+    /**
+     * Maps between graph nodes and scene coordinates for a builder's last graph,
+     * the same way the visualizer is handed a get_node_point callback
+     */
+    struct NodeLocator {
+        std::function<geometry::Point(std::size_t)> node_point;
+        std::function<std::optional<std::size_t>(const geometry::Point&)> node_id;
+    };
+
+    /**
+     * Locator forwarding to builder->get_node_point / builder->get_node_id
+     */
+    template <typename Builder>
+    NodeLocator make_node_locator(const std::shared_ptr<Builder>& builder) {
+        return {
+            [builder](std::size_t node_id) { return builder->get_node_point(node_id); },
+            [builder](const geometry::Point& point) -> std::optional<std::size_t> {
+                auto node = builder->get_node_id(point);
+                if (!node) {
+                    return std::nullopt;
+                }
+                return static_cast<std::size_t>(*node);
+            }
+        };
+    }
+
+    /**
+     * Graph prepared for searching: CSR edges plus the coordinates of every node
+     */
+    struct SearchGraph {
+        graph::CsrGraph graph;
+        std::vector<geometry::Point> points;
+    };
+
+    /**
+     * Base for planners that search the graph produced by a GraphBuilder
+     */
+    class GraphPlanner : public Planner {
+    public:
+        GraphPlanner(std::shared_ptr<graph::GraphBuilder> builder, NodeLocator locator);
+
+        [[nodiscard]] const std::shared_ptr<graph::GraphBuilder>& get_graph_builder() const { return builder_; }
+
+        /**
+         * Grid graphs are looked up in the cache before they are built and
+         * stored after; an entry the grid builder rejects is rebuilt and
+         * stored over. Other builders keep building: their node lookup needs
+         * state a cached graph cannot restore. nullptr disables the cache.
+         */
+        void set_graph_cache(std::shared_ptr<const GraphCache> cache) { graph_cache_ = std::move(cache); }
+
+        /**
+         * Threads used by plan_batch; 0 (the default) means
+         * std::thread::hardware_concurrency()
+         */
+        [[nodiscard]] unsigned get_thread_count() const { return thread_count_; }
+        void set_thread_count(unsigned threads) { thread_count_ = threads; }
+
+    protected:
+        std::shared_ptr<graph::GraphBuilder> builder_;
+        NodeLocator locator_;
+        SearchGraph search_graph_;
+        std::shared_ptr<const GraphCache> graph_cache_;
+
+        unsigned thread_count_ = 0;
+        unsigned pool_threads_ = 0;
+        std::unique_ptr<ThreadPool> pool_;
+
+        /**
+         * Builds the graph of the scene into search_graph_
+         */
+        const SearchGraph& prepare(const geometry::Scene& scene);
+
+        [[nodiscard]] std::optional<graph::NodeId> locate(const geometry::Point& point) const;
+
+        /**
+         * Scene start, the node points, scene goal
+         */
+        [[nodiscard]] geometry::Path make_path(const geometry::Point& start, const geometry::Point& goal,
+                                               const std::vector<graph::NodeId>& nodes) const;
+
+        /**
+         * plan_batch of the graph planners: prepare_graph(workers) builds the
+         * graph once, then search(worker, start, goal) answers the queries in
+         * parallel, returning the nodes of the path or std::nullopt.
+         * Graphs built around the scene's start and goal cannot be shared, so
+         * their builders get Planner::plan_batch, one build per query.
+         */
+        template <typename PrepareFn, typename SearchFn>
+        [[nodiscard]] BatchResult plan_shared_batch(const geometry::Scene& scene, std::span<const Query> queries,
+                                                    PrepareFn&& prepare_graph, SearchFn&& search) {
+            if (builder_->depends_on_endpoints()) {
+                return Planner::plan_batch(scene, queries);
+            }
+
+            BatchResult batch;
+            batch.results.resize(queries.size());
+
+            // Graph construction reports into the batch, each query into its own result
+            instrumentation::ProfileScope profile_scope(batch.profile);
+            auto batch_start = std::chrono::steady_clock::now();
+            if (!pool_ || pool_threads_ != thread_count_) {
+                pool_ = std::make_unique<ThreadPool>(thread_count_);
+                pool_threads_ = thread_count_;
+            }
+            prepare_graph(pool_->size());
+
+            const std::string algorithm_name = name();
+            pool_->parallel_for(queries.size(), [&](std::size_t i, unsigned worker) {
+                BenchmarkResult& result = batch.results[i];
+                result.algorithm_name = algorithm_name;
+                instrumentation::ProfileScope query_scope(result.profile);
+
+                auto start_time = std::chrono::steady_clock::now();
+                auto start = locate(queries[i].start);
+                auto goal = locate(queries[i].goal);
+                if (start && goal) {
+                    if (auto nodes = search(worker, *start, *goal)) {
+                        result.path = make_path(queries[i].start, queries[i].goal, *nodes);
+                    }
+                }
+                auto end_time = std::chrono::steady_clock::now();
+                result.runtime_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+            });
+            auto batch_end = std::chrono::steady_clock::now();
+
+            batch.total_ms = std::chrono::duration<double, std::milli>(batch_end - batch_start).count();
+            if (batch.total_ms > 0.0) {
+                batch.queries_per_second = static_cast<double>(queries.size()) * 1000.0 / batch.total_ms;
+            }
+            return batch;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef ALGORITHMS_GRAPH_GRID_GRAPH_BUILDER_H
+#define ALGORITHMS_GRAPH_GRID_GRAPH_BUILDER_H
+
+#include "GraphBuilder.h"
+#include "CsrGraph.h"
+#include "ImplicitGridGraph.h"
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace algorithms::graph {
+
+    /**
+     * Builds a regular grid graph over the scene: one node per cell whose
+     * center is free, edges between 4- or 8-connected neighbouring cells
+     * whose connecting segment touches no obstacle.
+     */
+    class GridGraphBuilder : public GraphBuilder {
+    public:
+        explicit GridGraphBuilder(double grid_step = 1.0, bool allow_diagonal = true);
+
+        [[nodiscard]] Graph build(const geometry::Scene& scene) override;
+        [[nodiscard]] std::string name() const override;
+        [[nodiscard]] bool is_symmetric() const override { return true; }
+
+        /**
+         * Re-rasterizes only the cells around each changed disk and rewrites the
+         * adjacency of the cells whose connectivity changed. Node ids stay
+         * stable: freed cells get new ids at the end, blocked cells keep theirs
+         * with no edges. Falls back to a full rebuild if the grid size changed.
+         */
+        std::vector<std::size_t> update(const geometry::Scene& scene,
+                                        std::span<const geometry::ObstacleDelta> deltas,
+                                        Graph& graph) override;
+
+        /**
+         * Same graph as build(), emitted directly in compressed sparse row form
+         */
+        [[nodiscard]] CsrGraph build_csr(const geometry::Scene& scene);
+
+        /**
+         * Takes over a graph build_csr() produced earlier for the same scene and
+         * settings, e.g. from a GraphCache, without rasterizing the obstacles.
+         * The occupancy is rebuilt from the nodes and edges, so node ids,
+         * get_node_id() and update() behave as after that build.
+         * @throws std::invalid_argument if the graph cannot come from this grid
+         *         (points off the grid, two nodes in one cell, edges between
+         *         cells that are not neighbours); the builder is then unchanged
+         */
+        void restore(const geometry::Scene& scene, const CsrGraph& graph,
+                     std::span<const geometry::Point> node_points);
+
+        /**
+         * Implicit mode: only the occupancy bitmap is built, neighbours are
+         * derived on the fly. Points snap like get_node_id(), with the current
+         * snap radius. Does not touch the node mapping of build().
+         */
+        [[nodiscard]] ImplicitGridGraph build_implicit(const geometry::Scene& scene) const;
+
+        /**
+         * Blocked cells and blocked edges of the grid over the scene
+         */
+        [[nodiscard]] GridOccupancy build_occupancy(const geometry::Scene& scene) const;
+
+        /**
+         * Brings occupancy, built by build_occupancy() for an earlier version of
+         * the scene, up to date with deltas already applied to scene by
+         * re-rasterizing only the cells around each changed disk. Rebuilds it
+         * if the grid size changed.
+         * @return the re-rasterized windows; cells whose edges may have changed
+         *         lie at most one cell outside them
+         */
+        std::vector<CellWindow> update_occupancy(const geometry::Scene& scene,
+                                                 std::span<const geometry::ObstacleDelta> deltas,
+                                                 GridOccupancy& occupancy) const;
+
+        [[nodiscard]] geometry::Point get_node_point(NodeId node_id) const;
+
+        /**
+         * Node of the cell containing the point. If that cell is blocked (or the
+         * point lies outside the grid), the nearest free cell within
+         * get_snap_radius() rings of cells around it.
+         */
+        [[nodiscard]] std::optional<NodeId> get_node_id(const geometry::Point& point) const;
+
+        /**
+         * get_node_id for many query points at once
+         */
+        [[nodiscard]] std::vector<std::optional<NodeId>> get_node_ids(std::span<const geometry::Point> points) const;
+
+        [[nodiscard]] double get_grid_step() const { return grid_step_; }
+        [[nodiscard]] bool is_diagonal_allowed() const { return allow_diagonal_; }
+
+        /**
+         * Threads used by the build passes, which split the grid into tiles of rows.
+         * 0 means std::thread::hardware_concurrency(); the default is 1.
+         * Node ids do not depend on the thread count.
+         */
+        [[nodiscard]] unsigned get_thread_count() const { return thread_count_; }
+        void set_thread_count(unsigned threads);
+
+        [[nodiscard]] int get_snap_radius() const { return snap_radius_; }
+        void set_snap_radius(int cells);
+
+    private:
+        double grid_step_;
+        bool allow_diagonal_;
+        int snap_radius_ = 2;
+        unsigned thread_count_ = 1;
+
+        int grid_width_ = 0;
+        int grid_height_ = 0;
+
+        // Occupancy of the last build, kept for update()
+        GridOccupancy occupancy_;
+        std::vector<geometry::Point> node_to_point_;
+        // Dense cell (gy * grid_width + gx) -> node table, INVALID_NODE for cells
+        // that have never been free. Cells blocked by update() keep their node.
+        std::vector<NodeId> cell_to_node_;
+
+        [[nodiscard]] std::pair<int, int> grid_size(const geometry::Scene& scene) const;
+        void rasterize_disk(const geometry::Disk& disk, GridOccupancy::Layer layer,
+                            int vx, int vy, int row_first, int row_last,
+                            int column_first, int column_last, GridOccupancy& occupancy) const;
+        [[nodiscard]] CellWindow delta_window(const geometry::ObstacleDelta& delta, const GridOccupancy& occupancy) const;
+        void refresh_occupancy(const geometry::Scene& scene, const CellWindow& window, GridOccupancy& occupancy) const;
+        [[nodiscard]] std::uint16_t connectivity(int gx, int gy) const;
+        void create_nodes(const GridOccupancy& occupancy, const std::vector<int>& tiles);
+        [[nodiscard]] std::vector<int> row_tiles(const GridOccupancy& occupancy) const;
+        [[nodiscard]] unsigned resolved_thread_count() const;
+        int collect_edges(const GridOccupancy& occupancy, int gx, int gy, Graph::Edge* out) const;
+
+        [[nodiscard]] bool is_point_in_bounds(const geometry::Point& point, const geometry::Scene& scene) const;
+        [[nodiscard]] double calculate_distance(const geometry::Point& a, const geometry::Point& b) const;
+        [[nodiscard]] std::pair<int, int> point_to_grid(const geometry::Point& point) const;
+        [[nodiscard]] geometry::Point grid_to_point(int grid_x, int grid_y) const;
+    };
+
+}
+
+#endif
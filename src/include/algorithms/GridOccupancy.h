@@ -0,0 +1,191 @@
+#ifndef ALGORITHMS_GRAPH_GRID_OCCUPANCY_H
+#define ALGORITHMS_GRAPH_GRID_OCCUPANCY_H
+
+#include "../geometry/Point.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace algorithms::graph {
+
+    /**
+     * Rectangle of cells x0..x1, y0..y1 (inclusive)
+     */
+    struct CellWindow {
+        int x0 = 0;
+        int y0 = 0;
+        int x1 = -1;
+        int y1 = -1;
+    };
+
+    /**
+     * Packed blocked/free bitmap of a grid.
+     *
+     * Besides one bit per cell, every cell owns the bits of the edges leaving it
+     * towards +x, +y, (+x,+y) and (-x,+y), so each undirected edge between
+     * neighbouring cells is stored exactly once. A set bit means blocked.
+     */
+    class GridOccupancy {
+    public:
+        enum Layer : std::uint8_t {
+            Cell = 0,
+            EdgeX,            // (gx, gy) - (gx + 1, gy)
+            EdgeY,            // (gx, gy) - (gx, gy + 1)
+            EdgeDiagonal,     // (gx, gy) - (gx + 1, gy + 1)
+            EdgeAntiDiagonal, // (gx, gy) - (gx - 1, gy + 1)
+            LayerCount
+        };
+
+        /**
+         * Neighbour offsets shared by all grid consumers:
+         * 4-connectivity (up, right, down, left) followed by the diagonals
+         */
+        static constexpr std::array<int, 8> dx = {0, 1, 0, -1, -1, 1, 1, -1};
+        static constexpr std::array<int, 8> dy = {-1, 0, 1, 0, -1, -1, 1, 1};
+
+        GridOccupancy() = default;
+        GridOccupancy(int width, int height)
+            : width_(width), height_(height),
+              words_per_layer_((static_cast<std::size_t>(width) * height + 63) / 64),
+              bits_(words_per_layer_ * LayerCount, 0) {}
+
+        [[nodiscard]] int width() const { return width_; }
+        [[nodiscard]] int height() const { return height_; }
+        [[nodiscard]] std::size_t cell_count() const { return static_cast<std::size_t>(width_) * height_; }
+
+        [[nodiscard]] bool in_grid(int gx, int gy) const {
+            return gx >= 0 && gx < width_ && gy >= 0 && gy < height_;
+        }
+
+        [[nodiscard]] std::size_t index(int gx, int gy) const {
+            return static_cast<std::size_t>(gy) * width_ + static_cast<std::size_t>(gx);
+        }
+
+        [[nodiscard]] bool is_blocked(Layer layer, std::size_t cell) const {
+            std::size_t bit = layer * words_per_layer_ * 64 + cell;
+            return (bits_[bit >> 6] >> (bit & 63)) & 1u;
+        }
+
+        void set_blocked(Layer layer, std::size_t cell, bool blocked = true) {
+            std::size_t bit = layer * words_per_layer_ * 64 + cell;
+            std::uint64_t mask = std::uint64_t{1} << (bit & 63);
+            if (blocked) {
+                bits_[bit >> 6] |= mask;
+            } else {
+                bits_[bit >> 6] &= ~mask;
+            }
+        }
+
+        /**
+         * Marks cells first..last (inclusive, same layer) as blocked or free, a word at a time
+         */
+        void set_blocked_range(Layer layer, std::size_t first, std::size_t last, bool blocked = true) {
+            std::size_t begin = layer * words_per_layer_ * 64 + first;
+            std::size_t end = layer * words_per_layer_ * 64 + last + 1;
+            while (begin < end) {
+                std::size_t offset = begin & 63;
+                std::size_t count = std::min<std::size_t>(64 - offset, end - begin);
+                std::uint64_t mask = (count == 64 ? ~std::uint64_t{0} : ((std::uint64_t{1} << count) - 1)) << offset;
+                if (blocked) {
+                    bits_[begin >> 6] |= mask;
+                } else {
+                    bits_[begin >> 6] &= ~mask;
+                }
+                begin += count;
+            }
+        }
+
+        [[nodiscard]] bool is_cell_free(int gx, int gy) const {
+            return in_grid(gx, gy) && !is_blocked(Cell, index(gx, gy));
+        }
+
+        /**
+         * Layer and owning cell of the edge from (gx, gy) in direction dir
+         */
+        [[nodiscard]] std::pair<Layer, std::size_t> edge_slot(int gx, int gy, int dir) const {
+            int nx = gx + dx[dir];
+            int ny = gy + dy[dir];
+            switch (dir) {
+                case 0: return {EdgeY, index(nx, ny)};
+                case 1: return {EdgeX, index(gx, gy)};
+                case 2: return {EdgeY, index(gx, gy)};
+                case 3: return {EdgeX, index(nx, ny)};
+                case 4: return {EdgeDiagonal, index(nx, ny)};
+                case 5: return {EdgeAntiDiagonal, index(nx, ny)};
+                case 6: return {EdgeDiagonal, index(gx, gy)};
+                default: return {EdgeAntiDiagonal, index(gx, gy)};
+            }
+        }
+
+        /**
+         * True if both cells are free and the edge between them is not blocked
+         */
+        [[nodiscard]] bool is_edge_free(int gx, int gy, int dir) const {
+            if (!is_cell_free(gx, gy) || !is_cell_free(gx + dx[dir], gy + dy[dir])) {
+                return false;
+            }
+            auto [layer, cell] = edge_slot(gx, gy, dir);
+            return !is_blocked(layer, cell);
+        }
+
+        [[nodiscard]] std::size_t memory_bytes() const {
+            return bits_.size() * sizeof(std::uint64_t);
+        }
+
+    private:
+        int width_ = 0;
+        int height_ = 0;
+        std::size_t words_per_layer_ = 0;
+        std::vector<std::uint64_t> bits_;
+    };
+
+    /**
+     * Snapping helper shared by the grid consumers.
+     * Returns the cell containing the point if accept(gx, gy) holds for it; otherwise
+     * the accepted cell with the nearest center within `rings` rings of cells around it.
+     * Centers on ring k are at least (k - 0.5) * step away, which bounds the search.
+     */
+    template <typename Accept>
+    std::optional<std::pair<int, int>> find_nearest_cell(int width, int height, double step,
+                                                         const geometry::Point& point, int rings, Accept&& accept) {
+        const int grid_x = static_cast<int>(std::floor(point.x / step));
+        const int grid_y = static_cast<int>(std::floor(point.y / step));
+        if (grid_x >= 0 && grid_x < width && grid_y >= 0 && grid_y < height && accept(grid_x, grid_y)) {
+            return std::pair{grid_x, grid_y};
+        }
+
+        double min_distance = std::numeric_limits<double>::max();
+        std::optional<std::pair<int, int>> closest;
+        for (int ring = 1; ring <= rings; ++ring) {
+            if ((ring - 0.5) * step >= min_distance) {
+                break;
+            }
+            for (int gy = grid_y - ring; gy <= grid_y + ring; ++gy) {
+                if (gy < 0 || gy >= height) {
+                    continue;
+                }
+                bool full_row = (gy == grid_y - ring || gy == grid_y + ring);
+                for (int gx = grid_x - ring; gx <= grid_x + ring; gx += full_row ? 1 : 2 * ring) {
+                    if (gx < 0 || gx >= width || !accept(gx, gy)) {
+                        continue;
+                    }
+                    double dist = point.distance({(gx + 0.5) * step, (gy + 0.5) * step});
+                    if (dist < min_distance) {
+                        min_distance = dist;
+                        closest = std::pair{gx, gy};
+                    }
+                }
+            }
+        }
+        return closest;
+    }
+
+}
+
+#endif
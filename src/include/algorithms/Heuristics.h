@@ -0,0 +1,47 @@
+#ifndef ALGORITHMS_HEURISTICS_H
+#define ALGORITHMS_HEURISTICS_H
+
+#include "../geometry/Point.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace algorithms {
+
+    /**
+     * Straight-line distance; admissible for any graph whose edge weights are
+     * Euclidean lengths (grid and visibility graphs)
+     */
+    struct EuclideanHeuristic {
+        [[nodiscard]] double operator()(const geometry::Point& a, const geometry::Point& b) const {
+            return a.distance(b);
+        }
+        [[nodiscard]] static std::string name() { return "euclidean"; }
+    };
+
+    /**
+     * Exact distance on an obstacle-free 8-connected grid; tighter than
+     * Euclidean there, but not admissible for any-angle graphs
+     */
+    struct OctileHeuristic {
+        [[nodiscard]] double operator()(const geometry::Point& a, const geometry::Point& b) const {
+            double dx = std::abs(a.x - b.x);
+            double dy = std::abs(a.y - b.y);
+            return std::max(dx, dy) + (std::sqrt(2.0) - 1.0) * std::min(dx, dy);
+        }
+        [[nodiscard]] static std::string name() { return "octile"; }
+    };
+
+    /**
+     * No guidance: A* degenerates to Dijkstra
+     */
+    struct ZeroHeuristic {
+        [[nodiscard]] double operator()(const geometry::Point&, const geometry::Point&) const {
+            return 0.0;
+        }
+        [[nodiscard]] static std::string name() { return "dijkstra"; }
+    };
+
+}
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef ALGORITHMS_HPA_STAR_PLANNER_H
+#define ALGORITHMS_HPA_STAR_PLANNER_H
+
+#include "Planner.h"
+#include "GridGraphBuilder.h"
+#include "CsrGraph.h"
+#include "DaryHeap.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace algorithms {
+
+    /**
+     * Hierarchical pathfinding (HPA*) on the occupancy grid of a GridGraphBuilder.
+     *
+     * The grid is cut into square clusters. Every run of free crossings along
+     * the border of two clusters gets transitions at its ends and every 16 or
+     * so cells between, and every diagonal crossing with no orthogonal detour
+     * is a transition of its own; their cells are the abstract nodes. The
+     * shortest path inside the cluster between each pair of its nodes is
+     * precomputed and stored as a sequence of moves.
+     * A query joins start and goal to the nodes of their clusters, runs A* on
+     * the abstract graph, guided by landmark distances (ALT), and splices the
+     * stored moves of the edges it took. Start and goal at most two clusters
+     * apart are also searched directly on the grid and the shorter path wins.
+     * Paths are near-optimal, as clusters are only crossed at transitions: on
+     * random 200x200 scenes with the default cluster size they are about 1.5%
+     * longer than grid A* on average and up to about 1.2x for short paths that
+     * wind across borders; small clusters can do worse.
+     *
+     * The abstraction survives between calls. Obstacles are diffed by Disk::id
+     * and only the clusters whose cells or edges changed, and the borders
+     * they share with their neighbours, are recomputed; the landmark distances
+     * are then redone over the abstract graph, which is much smaller than the grid.
+     */
+    class HpaStarPlanner : public Planner {
+    public:
+        /**
+         * @param cluster_size side of a cluster in cells
+         */
+        explicit HpaStarPlanner(std::shared_ptr<graph::GridGraphBuilder> builder, int cluster_size = 32);
+
+        [[nodiscard]] PathResult find_path(const geometry::Scene& scene) override;
+
+        /**
+         * Brings the abstraction up to date once, then searches every query
+         */
+        [[nodiscard]] BatchResult plan_batch(const geometry::Scene& scene, std::span<const Query> queries) override;
+
+        [[nodiscard]] std::string name() const override;
+
+        /**
+         * Forgets the abstraction; the next call builds it from scratch
+         */
+        void reset();
+
+        [[nodiscard]] int get_cluster_size() const { return cluster_size_; }
+
+        /**
+         * Abstract nodes expanded by the last query
+         */
+        [[nodiscard]] std::size_t expanded() const { return expanded_; }
+
+        [[nodiscard]] std::size_t abstract_node_count() const { return abstract_.node_count(); }
+
+        /**
+         * Clusters whose inner paths the last call recomputed
+         */
+        [[nodiscard]] std::size_t rebuilt_clusters() const { return rebuilt_clusters_; }
+
+        /**
+         * Threads used to compute the inner paths of the clusters;
+         * 0 (the default) means std::thread::hardware_concurrency()
+         */
+        [[nodiscard]] unsigned get_thread_count() const { return thread_count_; }
+        void set_thread_count(unsigned threads) { thread_count_ = threads; }
+
+    private:
+        /**
+         * Free move from a cell of a cluster to a cell of a neighbouring one
+         * (grid indices)
+         */
+        struct Transition {
+            std::uint32_t inside;
+            std::uint32_t outside;
+        };
+
+        struct Cluster {
+            std::vector<std::uint32_t> cells; // abstract nodes (grid indices), sorted
+            // distances[i * n + j] between cells i and j inside the cluster,
+            // infinity if they are not connected there
+            std::vector<double> distances;
+            // Moves (GridOccupancy directions) from cell i to cell j, i < j, are
+            // moves[path_offsets[i * n + j] .. path_offsets[i * n + j + 1])
+            std::vector<std::uint32_t> path_offsets;
+            std::vector<std::uint8_t> moves;
+            std::vector<Transition> east;
+            std::vector<Transition> south;
+            // Diagonal moves down and out of the cluster with no orthogonal detour
+            std::vector<Transition> diagonal;
+        };
+
+        /**
+         * Dijkstra confined to a window of cells, with buffers grown to the largest one
+         */
+        struct LocalSearch {
+            DaryHeap<double> open;
+            std::vector<double> g;
+            std::vector<std::uint8_t> move;
+            std::vector<std::uint32_t> seen;
+            std::vector<std::uint32_t> closed;
+            std::uint32_t generation = 0;
+            graph::CellWindow window;
+            std::uint32_t source = 0;
+        };
+
+        std::shared_ptr<graph::GridGraphBuilder> builder_;
+        int cluster_size_;
+
+        // Scene and settings the abstraction was built for
+        graph::GridOccupancy occupancy_;
+        std::vector<geometry::Disk> obstacles_;
+        double step_ = 0.0;
+        bool diagonal_ = true;
+        double scene_width_ = 0.0;
+        double scene_height_ = 0.0;
+        bool has_abstraction_ = false;
+
+        int clusters_x_ = 0;
+        int clusters_y_ = 0;
+        std::vector<Cluster> clusters_;
+
+        // Abstract graph: the nodes of cluster c are node_base_[c] onwards
+        graph::CsrGraph abstract_;
+        std::vector<std::uint32_t> node_base_;
+        std::vector<std::uint32_t> node_cluster_;
+        std::vector<geometry::Point> node_points_;
+        // Abstract distances from a few landmark nodes near the grid boundary,
+        // landmark_distances_[v * landmark_count_ + l]; the triangle inequality
+        // over them bounds the remaining cost far tighter than the octile distance
+        std::size_t landmark_count_ = 0;
+        std::vector<double> landmark_distances_;
+
+        unsigned thread_count_ = 0;
+        unsigned pool_threads_ = 0;
+        std::unique_ptr<ThreadPool> pool_;
+        std::vector<LocalSearch> build_searches_;
+        std::size_t rebuilt_clusters_ = 0;
+
+        // Query state; the two extra abstract nodes are start and goal
+        LocalSearch start_search_;
+        LocalSearch goal_search_;
+        DaryHeap<double> open_;
+        std::vector<double> g_;
+        std::vector<graph::NodeId> parent_;
+        std::vector<std::uint32_t> seen_;
+        std::vector<std::uint32_t> closed_;
+        std::vector<double> goal_landmarks_;
+        std::uint32_t generation_ = 0;
+        std::size_t expanded_ = 0;
+
+        void prepare(const geometry::Scene& scene);
+        void rebuild(const std::vector<std::uint8_t>& dirty);
+        void find_transitions(int cluster);
+        void compute_paths(Cluster& cluster, LocalSearch& search) const;
+        void build_abstract_graph();
+        void compute_landmarks();
+
+        [[nodiscard]] PathResult find_prepared_path(const geometry::Point& start, const geometry::Point& goal);
+        /**
+         * Abstract A* from start_cell to goal_cell; false if no path shorter
+         * than bound exists
+         */
+        bool search(std::uint32_t start_cell, std::uint32_t goal_cell, double bound);
+
+        [[nodiscard]] int cluster_of(std::uint32_t cell) const;
+        [[nodiscard]] graph::CellWindow cluster_window(int cluster) const;
+        [[nodiscard]] geometry::Point cell_point(std::uint32_t cell) const;
+
+        /**
+         * Dijkstra from source inside window until every target (sorted) is settled
+         */
+        void local_search(LocalSearch& search, std::uint32_t source, const graph::CellWindow& window,
+                          std::span<const std::uint32_t> targets) const;
+
+        /**
+         * Distance from the source of the last local_search to cell, infinity
+         * if the search did not settle it
+         */
+        [[nodiscard]] double local_distance(const LocalSearch& search, std::uint32_t cell) const;
+
+        /**
+         * Moves from the source of the last local_search to cell, appended to moves
+         */
+        void append_local_moves(const LocalSearch& search, std::uint32_t cell, std::vector<std::uint8_t>& moves) const;
+    };
+
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef ALGORITHMS_GRAPH_IMPLICIT_GRID_GRAPH_H
+#define ALGORITHMS_GRAPH_IMPLICIT_GRID_GRAPH_H
+
+#include "GridOccupancy.h"
+#include "CsrGraph.h"
+#include "../geometry/Point.h"
+#include <cmath>
+#include <optional>
+#include <utility>
+
+namespace algorithms::graph {
+
+    /**
+     * Grid graph that stores only the occupancy bitmap and derives the
+     * 4- or 8-connected neighbours of a cell on demand.
+     * Node ids are cell indices (gy * width + gx); blocked cells are not nodes.
+     */
+    class ImplicitGridGraph {
+    public:
+        ImplicitGridGraph() = default;
+        ImplicitGridGraph(GridOccupancy occupancy, double grid_step, bool allow_diagonal, int snap_radius = 2)
+            : occupancy_(std::move(occupancy)), grid_step_(grid_step), allow_diagonal_(allow_diagonal),
+              snap_radius_(snap_radius) {}
+
+        [[nodiscard]] const GridOccupancy& occupancy() const { return occupancy_; }
+        [[nodiscard]] double get_grid_step() const { return grid_step_; }
+        [[nodiscard]] bool is_diagonal_allowed() const { return allow_diagonal_; }
+
+        /**
+         * Size of the node id space (all cells, free or not)
+         */
+        [[nodiscard]] std::size_t node_count() const { return occupancy_.cell_count(); }
+
+        [[nodiscard]] bool is_node(NodeId node) const {
+            return node < node_count() && !occupancy_.is_blocked(GridOccupancy::Cell, node);
+        }
+
+        [[nodiscard]] geometry::Point get_node_point(NodeId node) const {
+            int gx = static_cast<int>(node % occupancy_.width());
+            int gy = static_cast<int>(node / occupancy_.width());
+            return {(gx + 0.5) * grid_step_, (gy + 0.5) * grid_step_};
+        }
+
+        /**
+         * Cell containing the point; if it is blocked (or outside the grid), the
+         * nearest free cell center within snap_radius rings of cells, as
+         * GridGraphBuilder::get_node_id
+         */
+        [[nodiscard]] std::optional<NodeId> get_node_id(const geometry::Point& point) const {
+            auto cell = find_nearest_cell(occupancy_.width(), occupancy_.height(), grid_step_, point, snap_radius_,
+                                          [this](int gx, int gy) {
+                                              return occupancy_.is_cell_free(gx, gy);
+                                          });
+            if (!cell) {
+                return std::nullopt;
+            }
+            return static_cast<NodeId>(occupancy_.index(cell->first, cell->second));
+        }
+
+        /**
+         * Calls fn(neighbour, weight) for every traversable edge of node
+         */
+        template <typename Fn>
+        void for_each_neighbor(NodeId node, Fn&& fn) const {
+            int gx = static_cast<int>(node % occupancy_.width());
+            int gy = static_cast<int>(node / occupancy_.width());
+            const int num_directions = allow_diagonal_ ? 8 : 4;
+            const double diagonal_step = grid_step_ * std::sqrt(2.0);
+
+            for (int dir = 0; dir < num_directions; ++dir) {
+                if (!occupancy_.is_edge_free(gx, gy, dir)) {
+                    continue;
+                }
+                int nx = gx + GridOccupancy::dx[dir];
+                int ny = gy + GridOccupancy::dy[dir];
+                fn(static_cast<NodeId>(occupancy_.index(nx, ny)), dir < 4 ? grid_step_ : diagonal_step);
+            }
+        }
+
+        [[nodiscard]] std::size_t memory_bytes() const { return occupancy_.memory_bytes(); }
+
+    private:
+        GridOccupancy occupancy_;
+        double grid_step_ = 1.0;
+        bool allow_diagonal_ = true;
+        int snap_radius_ = 2;
+    };
+
+}
+
+#endif
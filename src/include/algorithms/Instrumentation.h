@@ -0,0 +1,181 @@
+#ifndef ALGORITHMS_INSTRUMENTATION_H
+#define ALGORITHMS_INSTRUMENTATION_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Opt-in phase timers and counters for builders and planners.
+ *
+ * Code reports into the Profile made active on the current thread by a
+ * ProfileScope; with no active profile the calls do nothing. Everything here
+ * compiles to nothing unless PATHFINDING_INSTRUMENTATION is defined (CMake
+ * option DIPLOMA_INSTRUMENTATION). Profile itself always exists, so results
+ * carrying one keep the same layout in both builds.
+ *
+ *     PF_SCOPED_TIMER("grid.edges");        // time until end of scope
+ *     PF_COUNT(nodes_expanded, 1);          // add to a Counters field
+ */
+namespace algorithms::instrumentation {
+
+    struct Counters {
+        std::uint64_t obstacle_tests = 0;  // disk containment tests and segment-vs-obstacles queries
+        std::uint64_t nodes_expanded = 0;
+        std::uint64_t heap_pushes = 0;
+        std::uint64_t heap_pops = 0;
+        std::uint64_t edges_relaxed = 0;   // edges that improved a tentative distance
+        std::uint64_t bytes_allocated = 0; // graph and search buffers grown
+
+        Counters& operator+=(const Counters& other) {
+            obstacle_tests += other.obstacle_tests;
+            nodes_expanded += other.nodes_expanded;
+            heap_pushes += other.heap_pushes;
+            heap_pops += other.heap_pops;
+            edges_relaxed += other.edges_relaxed;
+            bytes_allocated += other.bytes_allocated;
+            return *this;
+        }
+    };
+
+    struct PhaseTime {
+        std::string name;
+        double ms = 0.0;
+    };
+
+    struct Profile {
+        Counters counters;
+        std::vector<PhaseTime> phases; // in order of first occurrence
+
+        /**
+         * Adds ms to the phase called name, creating it on first use
+         */
+        void add_phase(const char* name, double ms) {
+            for (auto& phase : phases) {
+                if (phase.name == name) {
+                    phase.ms += ms;
+                    return;
+                }
+            }
+            phases.push_back({name, ms});
+        }
+
+        Profile& operator+=(const Profile& other) {
+            counters += other.counters;
+            for (const auto& phase : other.phases) {
+                add_phase(phase.name.c_str(), phase.ms);
+            }
+            return *this;
+        }
+    };
+
+#ifdef PATHFINDING_INSTRUMENTATION
+
+    inline constexpr bool ENABLED = true;
+
+    inline Profile*& active_profile() {
+        thread_local Profile* profile = nullptr;
+        return profile;
+    }
+
+    /**
+     * Makes profile the active one on this thread until the end of the scope;
+     * a null profile disables reporting within the scope
+     */
+    class ProfileScope {
+    public:
+        explicit ProfileScope(Profile* profile) : previous_(active_profile()) { active_profile() = profile; }
+        explicit ProfileScope(Profile& profile) : ProfileScope(&profile) {}
+        ~ProfileScope() { active_profile() = previous_; }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        Profile* previous_;
+    };
+
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(const char* name)
+            : name_(name), profile_(active_profile()), start_(std::chrono::steady_clock::now()) {}
+
+        ~ScopedTimer() {
+            if (profile_) {
+                auto end = std::chrono::steady_clock::now();
+                profile_->add_phase(name_, std::chrono::duration<double, std::milli>(end - start_).count());
+            }
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        const char* name_;
+        Profile* profile_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    /**
+     * Carries the active profile of a thread into worker threads: worker i
+     * opens a ProfileScope on branch(i), and merge() adds the branches to
+     * the parent once the workers are done
+     */
+    class ProfileFork {
+    public:
+        explicit ProfileFork(std::size_t branches)
+            : parent_(active_profile()), branches_(parent_ ? branches : 0) {}
+
+        [[nodiscard]] Profile* branch(std::size_t i) { return parent_ ? &branches_[i] : nullptr; }
+
+        void merge() {
+            for (const auto& branch : branches_) {
+                *parent_ += branch;
+            }
+            branches_.clear();
+        }
+
+    private:
+        Profile* parent_;
+        std::vector<Profile> branches_;
+    };
+
+    inline void count(std::uint64_t Counters::* field, std::uint64_t n) {
+        if (Profile* profile = active_profile()) {
+            profile->counters.*field += n;
+        }
+    }
+
+#define PF_CONCAT_INNER(a, b) a##b
+#define PF_CONCAT(a, b) PF_CONCAT_INNER(a, b)
+#define PF_SCOPED_TIMER(name) \
+    ::algorithms::instrumentation::ScopedTimer PF_CONCAT(pf_timer_, __LINE__)(name)
+#define PF_COUNT(field, n) \
+    ::algorithms::instrumentation::count(&::algorithms::instrumentation::Counters::field, (n))
+
+#else
+
+    inline constexpr bool ENABLED = false;
+
+    class ProfileScope {
+    public:
+        explicit ProfileScope(Profile*) {}
+        explicit ProfileScope(Profile&) {}
+    };
+
+    class ProfileFork {
+    public:
+        explicit ProfileFork(std::size_t) {}
+        [[nodiscard]] Profile* branch(std::size_t) { return nullptr; }
+        void merge() {}
+    };
+
+#define PF_SCOPED_TIMER(name) ((void)0)
+#define PF_COUNT(field, n) ((void)0)
+
+#endif
+
+}
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef ALGORITHMS_JPS_PLANNER_H
+#define ALGORITHMS_JPS_PLANNER_H
+
+#include "Planner.h"
+#include "GridGraphBuilder.h"
+#include "DaryHeap.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+    /**
+     * Jump Point Search on the occupancy grid of a GridGraphBuilder with
+     * diagonal moves enabled. No Graph is built: the search runs on a map of
+     * the grid graph's edges and only expands jump points.
+     *
+     * Every move is an edge of the builder's grid graph, so paths are as short
+     * as A* with the octile heuristic finds on it. The pruning rules are those
+     * of a grid where every two free neighbours are joined, diagonals included.
+     * They only hold where the grid graph looks like that: a cell with a
+     * blocked edge in its 3x3 neighbourhood is a jump point and is expanded
+     * in every direction, as plain A* would.
+     */
+    class JpsPlanner : public Planner {
+    public:
+        explicit JpsPlanner(std::shared_ptr<graph::GridGraphBuilder> builder);
+
+        [[nodiscard]] PathResult find_path(const geometry::Scene& scene) override;
+        [[nodiscard]] std::string name() const override;
+
+        /**
+         * Jump points expanded by the last query
+         */
+        [[nodiscard]] std::size_t expanded() const { return expanded_; }
+
+    private:
+        std::shared_ptr<graph::GridGraphBuilder> builder_;
+
+        // Per-cell flags: the low 8 bits are the free edges (GridOccupancy
+        // directions), then whether the cell is free and whether its 3x3
+        // neighbourhood has all edges between free cells
+        static constexpr std::uint16_t FREE = 1u << 8;
+        static constexpr std::uint16_t REGULAR = 1u << 9;
+
+        int width_ = 0;
+        int height_ = 0;
+        int stride_ = 0;
+        // Padded by one always-blocked cell on every side, so lookups need no bounds checks
+        std::vector<std::uint16_t> cells_;
+
+        DaryHeap<double> open_;
+        std::vector<double> g_;
+        std::vector<graph::NodeId> parent_;
+        std::vector<std::uint32_t> seen_;
+        std::vector<std::uint32_t> closed_;
+        std::uint32_t generation_ = 0;
+        std::size_t expanded_ = 0;
+
+        void build_cells(const graph::GridOccupancy& occupancy);
+
+        [[nodiscard]] std::uint16_t cell(int x, int y) const {
+            return cells_[static_cast<std::size_t>(y + 1) * stride_ + (x + 1)];
+        }
+
+        [[nodiscard]] bool walkable(int x, int y) const { return (cell(x, y) & FREE) != 0; }
+        [[nodiscard]] bool regular(int x, int y) const { return (cell(x, y) & REGULAR) != 0; }
+
+        [[nodiscard]] bool can_move(int x, int y, int dx, int dy) const {
+            return (cell(x, y) >> direction_of(dx, dy)) & 1u;
+        }
+
+        static int direction_of(int dx, int dy) {
+            static constexpr int directions[3][3] = {{4, 0, 5}, {3, -1, 1}, {7, 2, 6}};
+            return directions[dy + 1][dx + 1];
+        }
+
+        /**
+         * Moves from (x, y) in direction (dx, dy) until a jump point, the goal or a dead end
+         */
+        [[nodiscard]] std::optional<std::pair<int, int>> jump(int x, int y, int dx, int dy,
+                                                              int goal_x, int goal_y) const;
+
+        bool search(int start_x, int start_y, int goal_x, int goal_y);
+        void begin_query();
+    };
+
+}
+
+#endif
@@ -8,8 +8,12 @@
 #include <string>
 #include <chrono>
 #include <optional>
-#include "../geometry/scene.h"
-#include "../geometry/path.h"
+#include <span>
+#include <utility>
+#include <vector>
+#include "../geometry/Scene.h"
+#include "../geometry/Path.h"
+#include "Instrumentation.h"
 
 namespace algorithms {
 
@@ -19,12 +23,73 @@ namespace algorithms {
         geometry::Path path;
         double runtime_ms = 0.0;
         std::string algorithm_name;
+        instrumentation::Profile profile; // phases and counters; empty unless PATHFINDING_INSTRUMENTATION
+    };
+
+    /**
+     * One start/goal pair of a batch against a shared obstacle field
+     */
+    struct Query {
+        geometry::Point start;
+        geometry::Point goal;
+    };
+
+    struct BatchResult {
+        std::vector<BenchmarkResult> results; // one per query, in query order
+        double total_ms = 0.0;                // whole batch, graph construction included
+        double queries_per_second = 0.0;
+        instrumentation::Profile profile;     // work shared by the queries, e.g. graph construction
     };
 
     class Planner {
     public:
         [[nodiscard]] virtual PathResult find_path(const geometry::Scene& scene) = 0;
-        [[nodiscard]] virtual BenchmarkResult plan(const geometry::Scene& scene) = 0;
+
+        /**
+         * Runs find_path and measures its wall-clock time, collecting the
+         * instrumentation profile of the call
+         */
+        [[nodiscard]] virtual BenchmarkResult plan(const geometry::Scene& scene) {
+            BenchmarkResult result;
+            result.algorithm_name = name();
+            instrumentation::ProfileScope profile_scope(result.profile);
+
+            auto start_time = std::chrono::steady_clock::now();
+            PathResult path = find_path(scene);
+            auto end_time = std::chrono::steady_clock::now();
+
+            result.runtime_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+            if (path) {
+                result.path = std::move(*path);
+            }
+            return result;
+        }
+
+        /**
+         * Answers every query against the obstacles of the scene. The default
+         * runs plan() per query with the scene's start and goal replaced;
+         * planners that can share their graph between queries override it.
+         */
+        [[nodiscard]] virtual BatchResult plan_batch(const geometry::Scene& scene, std::span<const Query> queries) {
+            BatchResult batch;
+            batch.results.reserve(queries.size());
+
+            auto start_time = std::chrono::steady_clock::now();
+            geometry::Scene query_scene = scene;
+            for (const auto& query : queries) {
+                query_scene.start = query.start;
+                query_scene.goal = query.goal;
+                batch.results.push_back(plan(query_scene));
+            }
+            auto end_time = std::chrono::steady_clock::now();
+
+            batch.total_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+            if (batch.total_ms > 0.0) {
+                batch.queries_per_second = static_cast<double>(queries.size()) * 1000.0 / batch.total_ms;
+            }
+            return batch;
+        }
+
         [[nodiscard]] virtual std::string name() const = 0;
 
         virtual ~Planner() = default;
@@ -0,0 +1,103 @@
+#ifndef ALGORITHMS_GRAPH_TANGENT_GRAPH_BUILDER_H
+#define ALGORITHMS_GRAPH_TANGENT_GRAPH_BUILDER_H
+
+#include "GraphBuilder.h"
+#include "CsrGraph.h"
+#include "../geometry/DiskIndex.h"
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace algorithms::graph {
+
+    /**
+     * Exact visibility graph for disk obstacles.
+     *
+     * Nodes are the start, the goal and the tangent points of the free bitangent
+     * segments between every pair of disks and of the tangents from start/goal
+     * to every disk. Tangent points on the same disk are joined by arc edges
+     * weighted with the arc length, so shortest paths in this graph are the
+     * exact shortest paths among the disks.
+     */
+    class TangentGraphBuilder : public GraphBuilder {
+    public:
+        static constexpr NodeId START_NODE = 0;
+        static constexpr NodeId GOAL_NODE = 1;
+
+        /**
+         * @param arc_step angular spacing (radians) of the points append_edge_path
+         *                 emits along arc edges
+         */
+        explicit TangentGraphBuilder(double arc_step = 0.2);
+
+        [[nodiscard]] Graph build(const geometry::Scene& scene) override;
+        [[nodiscard]] std::string name() const override;
+        [[nodiscard]] bool is_symmetric() const override { return true; }
+        [[nodiscard]] bool depends_on_endpoints() const override { return true; }
+
+        /**
+         * Patches the graph around the changed disks instead of rebuilding it.
+         * Only the tangents of a changed disk, the segments crossing its old or
+         * new position and the arcs of the disks it overlaps are revisited.
+         * Tangent nodes that lose their segment keep their id with no edges,
+         * new ones are appended. Falls back to a full rebuild if start or goal
+         * moved or the deltas do not match the last built obstacles.
+         */
+        std::vector<std::size_t> update(const geometry::Scene& scene,
+                                        std::span<const geometry::ObstacleDelta> deltas,
+                                        Graph& graph) override;
+
+        void append_edge_path(std::size_t from, std::size_t to, std::vector<geometry::Point>& points) const override;
+
+        [[nodiscard]] geometry::Point get_node_point(NodeId node_id) const;
+
+        /**
+         * Start and goal resolve in O(1); any other point maps to the nearest
+         * node by a linear scan
+         */
+        [[nodiscard]] std::optional<NodeId> get_node_id(const geometry::Point& point) const;
+
+        [[nodiscard]] double get_arc_step() const { return arc_step_; }
+
+    private:
+        static constexpr std::size_t NO_DISK = std::numeric_limits<std::size_t>::max();
+
+        // Every tangent node ends exactly one straight segment; a node whose
+        // segment is gone is dead: no edges and disk == NO_DISK
+        struct TangentNode {
+            geometry::Point point;
+            std::size_t disk;
+            double angle;    // position on the disk boundary
+            NodeId partner;  // other end of the node's segment, none for start/goal
+        };
+
+        double arc_step_;
+        std::vector<TangentNode> nodes_;
+        std::vector<geometry::Disk> disks_;
+        // Tangent nodes of each disk, dead ones included until the disk's arcs are redone
+        std::vector<std::vector<NodeId>> disk_nodes_;
+        // Signed sweep (counter-clockwise positive) of the arc edge from -> to,
+        // keyed by (from << 32) | to
+        std::unordered_map<std::uint64_t, double> arc_sweeps_;
+
+        struct PendingEdge {
+            NodeId from;
+            NodeId to;
+            double weight;
+        };
+
+        NodeId add_node(const geometry::Point& point, std::size_t disk);
+        void add_segment(NodeId first, NodeId second, std::vector<PendingEdge>& edges);
+        void add_arc_edges(const geometry::DiskIndex& obstacles, std::vector<PendingEdge>& edges);
+        void add_disk_arcs(std::size_t disk, const geometry::DiskIndex& obstacles, std::vector<PendingEdge>& edges);
+
+        [[nodiscard]] bool is_segment_clear(const geometry::Point& a, const geometry::Point& b,
+                                            std::size_t skip_first, std::size_t skip_second,
+                                            const geometry::DiskIndex& obstacles) const;
+    };
+
+}
+
+#endif
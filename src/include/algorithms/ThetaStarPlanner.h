@@ -0,0 +1,79 @@
+#ifndef ALGORITHMS_THETA_STAR_PLANNER_H
+#define ALGORITHMS_THETA_STAR_PLANNER_H
+
+#include "Planner.h"
+#include "GridGraphBuilder.h"
+#include "DaryHeap.h"
+#include "../geometry/DiskIndex.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace algorithms {
+
+    /**
+     * Any-angle search (Theta*) on the occupancy grid of a GridGraphBuilder.
+     *
+     * Cells are expanded along the grid edges as in A*, but a cell reached
+     * from u may take u's parent as its own whenever the segment between the
+     * two centers clears every disk, so paths turn only at obstacles and need
+     * no smoothing. Lazy Theta* assumes that line of sight when a cell is
+     * reached and checks it only once the cell is expanded, falling back to
+     * the best expanded neighbour if it fails.
+     */
+    class ThetaStarPlanner : public Planner {
+    public:
+        enum class Variant { Theta, LazyTheta };
+
+        explicit ThetaStarPlanner(std::shared_ptr<graph::GridGraphBuilder> builder,
+                                  Variant variant = Variant::LazyTheta);
+
+        [[nodiscard]] PathResult find_path(const geometry::Scene& scene) override;
+
+        /**
+         * Rasterizes the grid and indexes the disks once, then searches every query
+         */
+        [[nodiscard]] BatchResult plan_batch(const geometry::Scene& scene, std::span<const Query> queries) override;
+
+        [[nodiscard]] std::string name() const override;
+
+        /**
+         * Cells expanded by the last query
+         */
+        [[nodiscard]] std::size_t expanded() const { return expanded_; }
+
+        /**
+         * Line-of-sight checks made by the last query
+         */
+        [[nodiscard]] std::size_t line_of_sight_checks() const { return line_of_sight_checks_; }
+
+    private:
+        std::shared_ptr<graph::GridGraphBuilder> builder_;
+        Variant variant_;
+
+        graph::GridOccupancy occupancy_;
+        geometry::DiskIndex obstacles_;
+        double step_ = 1.0;
+
+        DaryHeap<double> open_;
+        std::vector<double> g_;
+        std::vector<graph::NodeId> parent_;
+        std::vector<std::uint32_t> seen_;
+        std::vector<std::uint32_t> closed_;
+        std::uint32_t generation_ = 0;
+        std::size_t expanded_ = 0;
+        std::size_t line_of_sight_checks_ = 0;
+
+        void prepare(const geometry::Scene& scene);
+        [[nodiscard]] PathResult find_prepared_path(const geometry::Point& start, const geometry::Point& goal);
+
+        [[nodiscard]] geometry::Point cell_point(graph::NodeId node) const;
+        [[nodiscard]] bool line_of_sight(const geometry::Point& a, const geometry::Point& b);
+
+        bool search(graph::NodeId start, graph::NodeId goal);
+        void begin_query();
+    };
+
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef ALGORITHMS_THREAD_POOL_H
+#define ALGORITHMS_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace algorithms {
+
+    /**
+     * Fixed set of worker threads running index loops with work stealing.
+     *
+     * parallel_for splits the indices evenly between the workers. Each worker
+     * takes indices from the front of its own range; once that is empty it
+     * steals the back half of another worker's range, so a few slow
+     * iterations do not leave the other threads idle.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * @param threads workers including the calling thread;
+         *                0 means std::thread::hardware_concurrency()
+         */
+        explicit ThreadPool(unsigned threads = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        [[nodiscard]] unsigned size() const { return static_cast<unsigned>(ranges_.size()); }
+
+        /**
+         * Calls fn(index, worker) for every index in [0, count) and returns once
+         * all calls finished. worker < size() identifies the calling thread, e.g.
+         * for per-thread scratch buffers. The first exception thrown by fn is
+         * rethrown here.
+         */
+        template <typename Fn>
+        void parallel_for(std::size_t count, Fn&& fn) {
+            run(count, [&fn](std::size_t index, unsigned worker) { fn(index, worker); });
+        }
+
+    private:
+        struct alignas(64) Range {
+            std::mutex mutex;
+            std::size_t begin = 0;
+            std::size_t end = 0;
+        };
+
+        std::vector<Range> ranges_;
+        std::vector<std::thread> threads_;
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable done_;
+        std::function<void(std::size_t, unsigned)> job_;
+        std::uint64_t job_id_ = 0;
+        unsigned busy_ = 0;
+        bool stop_ = false;
+        std::exception_ptr error_;
+
+        void run(std::size_t count, const std::function<void(std::size_t, unsigned)>& job);
+        void worker_loop(unsigned worker);
+        void drain(unsigned worker);
+        bool take(unsigned worker, std::size_t& index);
+    };
+
+}
+
+#endif
@@ -5,7 +5,7 @@
 #ifndef GEOMETRY_DISK_H
 #define GEOMETRY_DISK_H
 
-#include "point.h"
+#include "Point.h"
 
 namespace geometry {
 
@@ -25,6 +25,28 @@ namespace geometry {
             return center.distance(p) <= radius;
         }
 
+        /**
+         * Distance from the center to the closest point of the segment [a, b]
+         */
+        [[nodiscard]] double distance_to_segment(const Point& a, const Point& b) const {
+            double dx = b.x - a.x;
+            double dy = b.y - a.y;
+            double length_sq = dx * dx + dy * dy;
+            double t = 0.0;
+            if (length_sq > 0.0) {
+                t = ((center.x - a.x) * dx + (center.y - a.y) * dy) / length_sq;
+                t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+            }
+            return center.distance({a.x + t * dx, a.y + t * dy});
+        }
+
+        /**
+         * Check if the segment [a, b] passes through or touches this disk
+         */
+        [[nodiscard]] bool intersects_segment(const Point& a, const Point& b) const {
+            return distance_to_segment(a, b) <= radius;
+        }
+
         /*
         [[nodiscard]] bool intersects(const Disk& other) const {
             double dist = center.distance(other.center);
@@ -36,8 +58,6 @@ namespace geometry {
             return 2.0 * PI * radius;
         }
 
-        bool intersects_segment(const Point& a, const Point& b) const;
-
         std::pair<Point, Point> tangents_from(const Point& external) const;
         */
     };
@@ -0,0 +1,191 @@
+#ifndef GEOMETRY_DISK_INDEX_H
+#define GEOMETRY_DISK_INDEX_H
+
+#include "Point.h"
+#include "Disk.h"
+#include "DiskSet.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace geometry {
+
+    /**
+     * Uniform bucket grid over a set of disks.
+     *
+     * Every disk is registered in all buckets its bounding box overlaps, so a
+     * point query only looks at one bucket and a segment query only at the
+     * buckets the segment passes through. Query results are positions in the
+     * span the index was built from (e.g. Scene::obstacles).
+     *
+     * Each bucket also keeps its disks contiguously in a DiskSet, so the point
+     * and segment tests of a bucket run as one SIMD kernel call.
+     */
+    class DiskIndex {
+    public:
+        DiskIndex() = default;
+
+        /**
+         * @param cell_size bucket side length; 0 picks one from the disk sizes
+         */
+        explicit DiskIndex(std::span<const Disk> disks, double cell_size = 0.0);
+
+        [[nodiscard]] bool empty() const { return disks_.empty(); }
+        [[nodiscard]] std::size_t size() const { return disks_.size(); }
+        [[nodiscard]] const Disk& disk(std::size_t i) const { return disks_[i]; }
+        [[nodiscard]] double get_cell_size() const { return cell_size_; }
+
+        /**
+         * True if the point is inside or on the boundary of any disk
+         */
+        [[nodiscard]] bool contains(const Point& p) const;
+
+        /**
+         * Position of some disk containing the point
+         */
+        [[nodiscard]] std::optional<std::size_t> find_containing(const Point& p) const;
+
+        /**
+         * True if the segment [a, b] touches any disk
+         */
+        [[nodiscard]] bool intersects_segment(const Point& a, const Point& b) const;
+
+        /**
+         * Up to k disks closest to the point, nearest first.
+         * Distance is measured to the disk, i.e. 0 for disks containing the point.
+         */
+        [[nodiscard]] std::vector<std::size_t> k_nearest(const Point& p, std::size_t k) const;
+
+        /**
+         * Calls fn(position) for every disk registered in the buckets overlapping
+         * the box [min, max]. A disk spanning several buckets is reported once per bucket.
+         */
+        template <typename Fn>
+        void for_each_candidate(const Point& min, const Point& max, Fn&& fn) const {
+            if (disks_.empty()) {
+                return;
+            }
+            int x0 = clamp_x(bucket_x(min.x));
+            int x1 = clamp_x(bucket_x(max.x));
+            int y0 = clamp_y(bucket_y(min.y));
+            int y1 = clamp_y(bucket_y(max.y));
+            for (int by = y0; by <= y1; ++by) {
+                for (int bx = x0; bx <= x1; ++bx) {
+                    std::size_t bucket = static_cast<std::size_t>(by) * columns_ + bx;
+                    for (std::uint32_t i = bucket_offsets_[bucket]; i < bucket_offsets_[bucket + 1]; ++i) {
+                        fn(static_cast<std::size_t>(bucket_items_[i]));
+                    }
+                }
+            }
+        }
+
+        /**
+         * Calls fn(position) for the disks registered in the buckets the segment
+         * [a, b] passes through, until fn returns true.
+         * @return true if fn stopped the walk
+         */
+        template <typename Fn>
+        bool any_along_segment(const Point& a, const Point& b, Fn&& fn) const {
+            return any_bucket_along_segment(a, b, [&](std::size_t bucket) {
+                for (std::uint32_t i = bucket_offsets_[bucket]; i < bucket_offsets_[bucket + 1]; ++i) {
+                    if (fn(static_cast<std::size_t>(bucket_items_[i]))) {
+                        return true;
+                    }
+                }
+                return false;
+            });
+        }
+
+        /**
+         * Calls fn(position) for the disks the segment [a, b] touches, with the
+         * tolerance of DiskSet::first_intersecting, until fn returns true.
+         * Disks are tested by the SIMD kernel; fn only sees the hits, and a
+         * disk spanning several buckets may be reported more than once.
+         * @return true if fn stopped the walk
+         */
+        template <typename Fn>
+        bool any_intersecting(const Point& a, const Point& b, double tolerance, Fn&& fn) const {
+            return any_bucket_along_segment(a, b, [&](std::size_t bucket) {
+                const std::size_t end = bucket_offsets_[bucket + 1];
+                for (std::size_t i = bucket_offsets_[bucket]; ; ++i) {
+                    i = bucket_disks_.first_intersecting(a, b, i, end, tolerance);
+                    if (i == end) {
+                        return false;
+                    }
+                    if (fn(static_cast<std::size_t>(bucket_items_[i]))) {
+                        return true;
+                    }
+                }
+            });
+        }
+
+    private:
+        std::vector<Disk> disks_;
+        double cell_size_ = 1.0;
+        double origin_x_ = 0.0;
+        double origin_y_ = 0.0;
+        int columns_ = 0;
+        int rows_ = 0;
+
+        // Disk positions of bucket b are bucket_items_[bucket_offsets_[b] .. bucket_offsets_[b + 1])
+        std::vector<std::uint32_t> bucket_offsets_;
+        std::vector<std::uint32_t> bucket_items_;
+        // The disks of bucket_items_, in the same order
+        DiskSet bucket_disks_;
+
+        /**
+         * Calls fn(bucket) for the buckets the segment [a, b] passes through,
+         * until fn returns true
+         */
+        template <typename Fn>
+        bool any_bucket_along_segment(const Point& a, const Point& b, Fn&& fn) const {
+            if (disks_.empty()) {
+                return false;
+            }
+
+            // Walk the bucket columns spanned by the segment and, in each column,
+            // the bucket rows covered by the part of the segment inside it
+            const Point& left = a.x <= b.x ? a : b;
+            const Point& right = a.x <= b.x ? b : a;
+            const double grid_max_x = origin_x_ + columns_ * cell_size_;
+            const double grid_max_y = origin_y_ + rows_ * cell_size_;
+            if (right.x < origin_x_ || left.x > grid_max_x ||
+                std::max(a.y, b.y) < origin_y_ || std::min(a.y, b.y) > grid_max_y) {
+                return false;
+            }
+
+            const double dx = right.x - left.x;
+            int x0 = clamp_x(bucket_x(left.x));
+            int x1 = clamp_x(bucket_x(right.x));
+            for (int bx = x0; bx <= x1; ++bx) {
+                double column_x0 = std::max(left.x, origin_x_ + bx * cell_size_);
+                double column_x1 = std::min(right.x, origin_x_ + (bx + 1) * cell_size_);
+                double y0 = left.y;
+                double y1 = right.y;
+                if (dx > 0.0) {
+                    y0 = left.y + (right.y - left.y) * ((column_x0 - left.x) / dx);
+                    y1 = left.y + (right.y - left.y) * ((column_x1 - left.x) / dx);
+                }
+                int by0 = clamp_y(bucket_y(std::min(y0, y1)));
+                int by1 = clamp_y(bucket_y(std::max(y0, y1)));
+                for (int by = by0; by <= by1; ++by) {
+                    if (fn(static_cast<std::size_t>(by) * columns_ + bx)) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        [[nodiscard]] int bucket_x(double x) const;
+        [[nodiscard]] int bucket_y(double y) const;
+        [[nodiscard]] int clamp_x(int bx) const { return bx < 0 ? 0 : (bx >= columns_ ? columns_ - 1 : bx); }
+        [[nodiscard]] int clamp_y(int by) const { return by < 0 ? 0 : (by >= rows_ ? rows_ - 1 : by); }
+    };
+
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef GEOMETRY_DISK_SET_H
+#define GEOMETRY_DISK_SET_H
+
+#include "Point.h"
+#include "Disk.h"
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace geometry {
+
+    /**
+     * Disks stored as a structure of arrays (center x, center y, radius) so
+     * that point and segment tests run over several disks per instruction.
+     *
+     * Tests compare squared distances, so no square root is taken. The kernel
+     * (AVX2, SSE2 or scalar) is picked once at runtime from the CPU. All kernels
+     * do the same arithmetic in the same order and give identical results.
+     */
+    class DiskSet {
+    public:
+        enum class SimdLevel { Scalar, Sse2, Avx2 };
+
+        DiskSet() = default;
+        explicit DiskSet(std::span<const Disk> disks);
+
+        void reserve(std::size_t count);
+        void push_back(const Disk& disk);
+        void clear();
+
+        [[nodiscard]] bool empty() const { return x_.empty(); }
+        [[nodiscard]] std::size_t size() const { return x_.size(); }
+        [[nodiscard]] Disk disk(std::size_t i) const { return {{x_[i], y_[i]}, radius_[i]}; }
+
+        /**
+         * First disk in [begin, end) containing the point (boundary included),
+         * or end if there is none
+         */
+        [[nodiscard]] std::size_t first_containing(const Point& p, std::size_t begin, std::size_t end) const;
+
+        /**
+         * First disk in [begin, end) touched by the segment [a, b], or end.
+         * With tolerance > 0 every radius r is first shrunk to
+         * r - tolerance * (1 + r), so segments grazing a disk do not count.
+         */
+        [[nodiscard]] std::size_t first_intersecting(const Point& a, const Point& b,
+                                                     std::size_t begin, std::size_t end,
+                                                     double tolerance = 0.0) const;
+
+        [[nodiscard]] std::size_t memory_bytes() const {
+            return (x_.capacity() + y_.capacity() + radius_.capacity()) * sizeof(double);
+        }
+
+        /**
+         * Kernel used by all DiskSets
+         */
+        [[nodiscard]] static SimdLevel simd_level();
+
+        /**
+         * Selects a kernel, e.g. to compare them in benchmarks. Levels the CPU
+         * does not support fall back to the best supported one.
+         */
+        static void set_simd_level(SimdLevel level);
+
+    private:
+        std::vector<double> x_;
+        std::vector<double> y_;
+        std::vector<double> radius_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef GEOMETRY_OBSTACLE_DELTA_H
+#define GEOMETRY_OBSTACLE_DELTA_H
+
+#include "Disk.h"
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace geometry {
+
+    /**
+     * One change to the obstacles of a scene. Disks are matched by Disk::id;
+     * `before` is the disk as it was (Removed, Moved), `after` as it is now
+     * (Added, Moved).
+     */
+    struct ObstacleDelta {
+        enum class Kind {
+            Added,
+            Removed,
+            Moved
+        };
+
+        Kind kind = Kind::Added;
+        Disk before{};
+        Disk after{};
+
+        static ObstacleDelta added(const Disk& disk) {
+            return {Kind::Added, {}, disk};
+        }
+
+        static ObstacleDelta removed(const Disk& disk) {
+            return {Kind::Removed, disk, {}};
+        }
+
+        static ObstacleDelta moved(const Disk& from, const Disk& to) {
+            return {Kind::Moved, from, to};
+        }
+    };
+
+    /**
+     * Changes that turn the obstacles `before` into `after`, matching disks by Disk::id
+     */
+    inline std::vector<ObstacleDelta> diff_obstacles(std::span<const Disk> before, std::span<const Disk> after) {
+        std::unordered_map<std::size_t, std::size_t> previous;
+        previous.reserve(before.size());
+        for (std::size_t i = 0; i < before.size(); ++i) {
+            previous.emplace(before[i].id, i);
+        }
+
+        std::vector<ObstacleDelta> deltas;
+        std::vector<std::uint8_t> kept(before.size(), 0);
+        for (const auto& disk : after) {
+            auto it = previous.find(disk.id);
+            if (it == previous.end()) {
+                deltas.push_back(ObstacleDelta::added(disk));
+                continue;
+            }
+            const Disk& old = before[it->second];
+            kept[it->second] = 1;
+            if (!(old.center == disk.center) || old.radius != disk.radius) {
+                deltas.push_back(ObstacleDelta::moved(old, disk));
+            }
+        }
+        for (std::size_t i = 0; i < before.size(); ++i) {
+            if (!kept[i]) {
+                deltas.push_back(ObstacleDelta::removed(before[i]));
+            }
+        }
+        return deltas;
+    }
+
+}
+
+#endif
@@ -5,8 +5,8 @@
 #ifndef GEOMETRY_PATH_H
 #define GEOMETRY_PATH_H
 
-#include "point.h"
-#include "scene.h"
+#include "Point.h"
+#include "Scene.h"
 
 #include <vector>
 
@@ -5,8 +5,11 @@
 #ifndef GEOMETRY_SCENE_H
 #define GEOMETRY_SCENE_H
 
-#include "point.h"
-#include "disk.h"
+#include "Point.h"
+#include "Disk.h"
+#include "ObstacleDelta.h"
+#include <algorithm>
+#include <stdexcept>
 #include <vector>
 
 namespace geometry {
@@ -25,6 +28,27 @@ namespace geometry {
         void add_obstacle(const Disk& disk) {
             obstacles.push_back(disk);
         }
+
+        /**
+         * Applies the delta to obstacles, looking disks up by Disk::id
+         */
+        void apply(const ObstacleDelta& delta) {
+            if (delta.kind == ObstacleDelta::Kind::Added) {
+                add_obstacle(delta.after);
+                return;
+            }
+
+            auto it = std::find_if(obstacles.begin(), obstacles.end(),
+                                   [&](const Disk& disk) { return disk.id == delta.before.id; });
+            if (it == obstacles.end()) {
+                throw std::invalid_argument("No obstacle with the given id");
+            }
+            if (delta.kind == ObstacleDelta::Kind::Removed) {
+                obstacles.erase(it);
+            } else {
+                *it = delta.after;
+            }
+        }
     };
 
 }
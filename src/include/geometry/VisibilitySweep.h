@@ -0,0 +1,165 @@
+#ifndef GEOMETRY_VISIBILITY_SWEEP_H
+#define GEOMETRY_VISIBILITY_SWEEP_H
+
+#include "Point.h"
+#include "Disk.h"
+#include "DiskIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <set>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace geometry {
+
+    /**
+     * Rotational plane sweep answering "which of these segments are free"
+     * among disk obstacles, for segments leaving one source.
+     *
+     * The source is a point or the boundary of a disk. Every segment lies on a
+     * ray of a one-parameter family: the rays from the point, or the tangent
+     * rays of the disk turning one way round it. Every disk apart from the
+     * source is hit by the rays of one angular interval. The sweep walks the
+     * interval ends and the segment angles in order and keeps the hit disks in
+     * a set ordered by where the current ray enters them. That order only
+     * changes where the rays pass a crossing point of two overlapping circles,
+     * and those crossings are events of the sweep as well. A segment is then
+     * tested against the front of the set up to its end only, which is the
+     * blocking disk or a disk it grazes. Disks overlapping the source are
+     * tested directly, and segments ending inside a disk are rejected before
+     * the sweep, which is skipped when none are left. Disks whose interval
+     * holds no segment never reach a test and are left out.
+     *
+     * For m disks, p overlapping pairs and k segments a sweep costs
+     * O((m + p + k) log m) plus the direct tests.
+     */
+    class VisibilitySweep {
+    public:
+        static constexpr std::size_t NO_DISK = std::numeric_limits<std::size_t>::max();
+
+        struct Target {
+            Point point;
+            std::size_t disk = NO_DISK; // disk the target lies on, transparent for it
+        };
+
+        /**
+         * Segment leaving the boundary of the source disk along its tangent
+         */
+        struct TangentTarget {
+            Point from;
+            Point to;
+            std::size_t disk = NO_DISK; // disk the end lies on, transparent for it
+        };
+
+        explicit VisibilitySweep(std::span<const Disk> disks);
+
+        // The active set's ordering refers back to this object
+        VisibilitySweep(const VisibilitySweep&) = delete;
+        VisibilitySweep& operator=(const VisibilitySweep&) = delete;
+
+        [[nodiscard]] std::size_t size() const { return disks_.size(); }
+
+        /**
+         * Sets visible[i] to whether targets[i] can be seen from the viewpoint.
+         * Segments grazing a disk are not blocked by it.
+         */
+        void visible_from(const Point& viewpoint, std::span<const Target> targets, std::vector<bool>& visible);
+
+        /**
+         * Sets visible[i] to whether the segment targets[i] is free. Every
+         * segment must start on the boundary of disk source and be tangent to
+         * it there (a bitangent); the source disk is transparent.
+         */
+        void visible_along_tangents(std::size_t source, std::span<const TangentTarget> targets,
+                                    std::vector<bool>& visible);
+
+    private:
+        enum class EventKind : std::uint8_t {
+            Insert,
+            Swap,
+            Query,
+            Remove
+        };
+
+        struct Event {
+            double angle;
+            EventKind kind;
+            std::uint32_t index;
+        };
+
+        struct Segment {
+            Point from;
+            Point to;
+            std::size_t disk;
+            std::uint32_t index; // position in the caller's targets
+            bool clockwise;      // turning direction round the source disk
+        };
+
+        // Rays of the current source touching a disk, in the source's polar
+        // angle: the line at distance radius + disk.radius (near) and
+        // radius - disk.radius (far) from the center, on the disk's side
+        struct Reach {
+            double toward;
+            double near;
+            double far;
+            Point toward_direction;
+            Point near_direction; // (cos near, sin near)
+            Point far_direction;
+        };
+
+        // Orders the active disks by where the current ray enters them
+        struct EntryOrder {
+            const VisibilitySweep* sweep;
+            bool operator()(std::uint32_t a, std::uint32_t b) const;
+        };
+
+        using ActiveSet = std::pmr::set<std::uint32_t, EntryOrder>;
+
+        struct Crossing {
+            Point point;
+            std::uint32_t first;
+            std::uint32_t second;
+        };
+
+        std::vector<Disk> disks_;
+        DiskIndex index_;
+        // Boundary crossings of overlapping disks, where their entry order can swap
+        std::vector<Crossing> crossings_;
+
+        // Current source and ray: the ray at angle phi starts at
+        // center + radius * (cos phi, sin phi) and runs along
+        // orientation * (-sin phi, cos phi)
+        Point center_;
+        double radius_ = 0.0;
+        double orientation_ = 1.0;
+        Point ray_origin_;
+        Point ray_direction_;
+
+        // Per-sweep scratch, kept to avoid reallocating between sweeps
+        std::vector<Event> events_;
+        std::vector<Segment> segments_;
+        std::vector<std::uint32_t> direct_;
+        std::vector<bool> swept_;
+        std::vector<Reach> reach_;
+        std::vector<Point> start_ray_;
+        std::vector<bool> reached_;
+        std::vector<double> query_angles_;
+        std::vector<ActiveSet::iterator> position_;
+        std::pmr::unsynchronized_pool_resource active_nodes_; // recycles the set's nodes
+        ActiveSet active_;
+
+        void prepare(const Point& center, double radius, std::size_t source);
+        void sweep(double orientation, std::vector<bool>& visible);
+        void set_ray(double cos_angle, double sin_angle);
+        [[nodiscard]] double ray_angle(const Point& p) const;
+        [[nodiscard]] double entry(std::uint32_t disk) const;
+        [[nodiscard]] bool is_covered(const Point& p, std::size_t skip_first, std::size_t skip_second) const;
+        void insert(std::uint32_t disk);
+    };
+
+}
+
+#endif
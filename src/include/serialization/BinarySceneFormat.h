@@ -0,0 +1,93 @@
+#ifndef SERIALIZATION_BINARY_SCENE_FORMAT_H
+#define SERIALIZATION_BINARY_SCENE_FORMAT_H
+
+#include "../geometry/Scene.h"
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace serialization {
+
+    /**
+     * Read-only scene backed by a memory-mapped binary scene file. The disk
+     * arrays point straight into the mapping; copies of the view share it,
+     * and it is unmapped when the last one goes away.
+     */
+    class SceneView {
+    public:
+        SceneView() = default;
+
+        [[nodiscard]] std::size_t size() const { return x_.size(); }
+        [[nodiscard]] bool empty() const { return x_.empty(); }
+
+        [[nodiscard]] std::span<const double> center_x() const { return x_; }
+        [[nodiscard]] std::span<const double> center_y() const { return y_; }
+        [[nodiscard]] std::span<const double> radius() const { return radius_; }
+        [[nodiscard]] std::span<const std::uint64_t> id() const { return id_; }
+
+        [[nodiscard]] geometry::Disk disk(std::size_t i) const {
+            return {{x_[i], y_[i]}, radius_[i], static_cast<std::size_t>(id_[i])};
+        }
+
+        [[nodiscard]] const geometry::Point& start() const { return start_; }
+        [[nodiscard]] const geometry::Point& goal() const { return goal_; }
+        [[nodiscard]] double width() const { return width_; }
+        [[nodiscard]] double height() const { return height_; }
+
+        /**
+         * Copies the view into a Scene, for code that needs one
+         */
+        [[nodiscard]] geometry::Scene to_scene() const;
+
+    private:
+        friend class BinarySceneFormat;
+
+        std::shared_ptr<const MappedFile> mapping_;
+        std::span<const double> x_;
+        std::span<const double> y_;
+        std::span<const double> radius_;
+        std::span<const std::uint64_t> id_;
+        geometry::Point start_ {0, 0};
+        geometry::Point goal_ {0, 0};
+        double width_ = 0.0;
+        double height_ = 0.0;
+    };
+
+    /**
+     * Versioned little-endian binary scene file: a fixed header (magic,
+     * version, header size, disk count, scene size, start, goal) followed by
+     * packed arrays of center x, center y, radius and id, one disk each.
+     */
+    class BinarySceneFormat {
+    public:
+        static constexpr std::uint32_t VERSION = 1;
+
+        /**
+         * @return false if the file could not be written
+         */
+        static bool save_to_file(const geometry::Scene& scene, const std::string& filename);
+
+        /**
+         * Maps the file without copying the disk arrays.
+         * Throws std::runtime_error if it is not a valid binary scene file.
+         */
+        [[nodiscard]] static SceneView map_file(const std::string& filename);
+
+        /**
+         * True if the file starts with the binary scene magic
+         */
+        [[nodiscard]] static bool is_binary_file(const std::string& filename);
+
+        /**
+         * Loads a binary scene file, or a JSON one through SceneJsonStream,
+         * whichever the file turns out to be
+         */
+        [[nodiscard]] static geometry::Scene load_any_from_file(const std::string& filename);
+    };
+
+}
+
+#endif
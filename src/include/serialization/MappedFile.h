@@ -0,0 +1,34 @@
+#ifndef SERIALIZATION_MAPPED_FILE_H
+#define SERIALIZATION_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace serialization {
+
+    /**
+     * Whole file mapped read-only (mmap, or MapViewOfFile on Windows),
+     * unmapped on destruction
+     */
+    class MappedFile {
+    public:
+        /**
+         * Throws std::runtime_error if the file cannot be opened or is empty
+         */
+        explicit MappedFile(const std::string& filename);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] const std::byte* data() const { return data_; }
+        [[nodiscard]] std::size_t size() const { return size_; }
+
+    private:
+        const std::byte* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef SERIALIZATION_SCENE_JSON_STREAM_H
+#define SERIALIZATION_SCENE_JSON_STREAM_H
+
+#include "../geometry/Scene.h"
+#include <iosfwd>
+#include <string>
+
+namespace serialization {
+
+    /**
+     * Streaming reader and writer for JSON scene files, for obstacle sets too
+     * large for a JSON DOM.
+     *
+     * The reader is a SAX handler that appends each disk to Scene::obstacles
+     * as soon as its object closes, so peak memory is the scene itself. The
+     * writer emits obstacle_count before the obstacles, and the reader
+     * reserves the vector when it sees it, up to about a million disks.
+     *
+     *     {"width": 100, "height": 100,
+     *      "start": {"x": 1, "y": 1}, "goal": {"x": 99, "y": 99},
+     *      "obstacle_count": 1,
+     *      "obstacles": [{"center": {"x": 50, "y": 50}, "radius": 5, "id": 0}]}
+     *
+     * Points may also be [x, y] arrays and disks may carry x and y directly.
+     * Unknown keys are skipped.
+     */
+    class SceneJsonStream {
+    public:
+        /**
+         * Throws std::runtime_error on malformed JSON, an incomplete disk, or
+         * an id or obstacle_count that is not a non-negative integer
+         */
+        [[nodiscard]] static geometry::Scene read(std::istream& in);
+        [[nodiscard]] static geometry::Scene load_from_file(const std::string& filename);
+
+        static void write(const geometry::Scene& scene, std::ostream& out);
+
+        /**
+         * @return false if the file could not be written
+         */
+        static bool save_to_file(const geometry::Scene& scene, const std::string& filename);
+    };
+
+}
+
+#endif
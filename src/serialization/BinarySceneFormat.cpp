@@ -0,0 +1,156 @@
+//
+// Implementation of BinarySceneFormat
+//
+
+#include "../include/serialization/BinarySceneFormat.h"
+#include "../include/serialization/SceneJsonStream.h"
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace serialization {
+
+    namespace {
+
+        constexpr char MAGIC[8] = {'P', 'F', 'S', 'C', 'E', 'N', 'E', '\0'};
+
+        // Followed by header_size - sizeof(Header) bytes later versions may
+        // add, then the four arrays of disk_count values each
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t header_size;
+            std::uint64_t disk_count;
+            double width;
+            double height;
+            double start_x;
+            double start_y;
+            double goal_x;
+            double goal_y;
+        };
+        static_assert(sizeof(Header) == 72, "Header must have no padding");
+
+        constexpr std::size_t BYTES_PER_DISK = 3 * sizeof(double) + sizeof(std::uint64_t);
+
+        constexpr bool LITTLE_ENDIAN_HOST = std::endian::native == std::endian::little;
+
+        [[noreturn]] void fail(const std::string& message, const std::string& filename) {
+            throw std::runtime_error(message + ": " + filename);
+        }
+
+        template <typename T>
+        void write_column(std::ofstream& out, const geometry::Scene& scene, T (*field)(const geometry::Disk&)) {
+            std::vector<T> column;
+            column.reserve(scene.obstacles.size());
+            for (const auto& disk : scene.obstacles) {
+                column.push_back(field(disk));
+            }
+            out.write(reinterpret_cast<const char*>(column.data()),
+                      static_cast<std::streamsize>(column.size() * sizeof(T)));
+        }
+
+    }
+
+    geometry::Scene SceneView::to_scene() const {
+        geometry::Scene scene(start_, goal_, width_, height_);
+        scene.obstacles.reserve(size());
+        for (std::size_t i = 0; i < size(); ++i) {
+            scene.obstacles.push_back(disk(i));
+        }
+        return scene;
+    }
+
+    bool BinarySceneFormat::save_to_file(const geometry::Scene& scene, const std::string& filename) {
+        if constexpr (!LITTLE_ENDIAN_HOST) {
+            return false;
+        }
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+
+        Header header {};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.header_size = sizeof(Header);
+        header.disk_count = scene.obstacles.size();
+        header.width = scene.width;
+        header.height = scene.height;
+        header.start_x = scene.start.x;
+        header.start_y = scene.start.y;
+        header.goal_x = scene.goal.x;
+        header.goal_y = scene.goal.y;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        write_column<double>(out, scene, [](const geometry::Disk& disk) { return disk.center.x; });
+        write_column<double>(out, scene, [](const geometry::Disk& disk) { return disk.center.y; });
+        write_column<double>(out, scene, [](const geometry::Disk& disk) { return disk.radius; });
+        write_column<std::uint64_t>(out, scene, [](const geometry::Disk& disk) {
+            return static_cast<std::uint64_t>(disk.id);
+        });
+
+        out.flush();
+        return static_cast<bool>(out);
+    }
+
+    SceneView BinarySceneFormat::map_file(const std::string& filename) {
+        if constexpr (!LITTLE_ENDIAN_HOST) {
+            fail("Binary scene files need a little-endian host", filename);
+        }
+
+        auto mapping = std::make_shared<const MappedFile>(filename);
+        const std::size_t size = mapping->size();
+        if (size < sizeof(Header)) {
+            fail("Truncated binary scene header", filename);
+        }
+        Header header {};
+        std::memcpy(&header, mapping->data(), sizeof(Header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            fail("Not a binary scene file", filename);
+        }
+        if (header.version != VERSION) {
+            fail("Unsupported binary scene version " + std::to_string(header.version), filename);
+        }
+        // Keeps the arrays 8-byte aligned within the page-aligned mapping
+        if (header.header_size < sizeof(Header) || header.header_size % alignof(double) != 0 ||
+            header.header_size > size) {
+            fail("Invalid binary scene header size", filename);
+        }
+        if (header.disk_count > (size - header.header_size) / BYTES_PER_DISK) {
+            fail("Truncated binary scene disk arrays", filename);
+        }
+
+        const auto count = static_cast<std::size_t>(header.disk_count);
+        const std::byte* arrays = mapping->data() + header.header_size;
+        const auto* values = reinterpret_cast<const double*>(arrays);
+
+        SceneView view;
+        view.x_ = {values, count};
+        view.y_ = {values + count, count};
+        view.radius_ = {values + 2 * count, count};
+        view.id_ = {reinterpret_cast<const std::uint64_t*>(values + 3 * count), count};
+        view.start_ = {header.start_x, header.start_y};
+        view.goal_ = {header.goal_x, header.goal_y};
+        view.width_ = header.width;
+        view.height_ = header.height;
+        view.mapping_ = std::move(mapping);
+        return view;
+    }
+
+    bool BinarySceneFormat::is_binary_file(const std::string& filename) {
+        std::ifstream in(filename, std::ios::binary);
+        char magic[sizeof(MAGIC)] {};
+        in.read(magic, sizeof(magic));
+        return in.gcount() == sizeof(magic) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+    }
+
+    geometry::Scene BinarySceneFormat::load_any_from_file(const std::string& filename) {
+        if (is_binary_file(filename)) {
+            return map_file(filename).to_scene();
+        }
+        return SceneJsonStream::load_from_file(filename);
+    }
+
+} // namespace serialization
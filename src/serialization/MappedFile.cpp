@@ -0,0 +1,81 @@
+//
+// Implementation of MappedFile
+//
+
+#include "../include/serialization/MappedFile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace serialization {
+
+    namespace {
+
+        [[noreturn]] void fail(const std::string& message, const std::string& filename) {
+            throw std::runtime_error(message + ": " + filename);
+        }
+
+    }
+
+    MappedFile::MappedFile(const std::string& filename) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            fail("Cannot open file", filename);
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+            CloseHandle(file);
+            fail("Cannot map empty file", filename);
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr) {
+            fail("Cannot map file", filename);
+        }
+        // The view keeps the mapping object alive on its own
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (data == nullptr) {
+            fail("Cannot map file", filename);
+        }
+        size_ = static_cast<std::size_t>(file_size.QuadPart);
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            fail("Cannot open file", filename);
+        }
+        struct stat file_stat {};
+        if (::fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+            ::close(fd);
+            fail("Cannot map empty file", filename);
+        }
+        void* data = ::mmap(nullptr, static_cast<std::size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            fail("Cannot map file", filename);
+        }
+        size_ = static_cast<std::size_t>(file_stat.st_size);
+#endif
+        data_ = static_cast<const std::byte*>(data);
+    }
+
+    MappedFile::~MappedFile() {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+#else
+        ::munmap(const_cast<std::byte*>(data_), size_);
+#endif
+    }
+
+} // namespace serialization
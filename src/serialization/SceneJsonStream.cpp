@@ -0,0 +1,264 @@
+//
+// Implementation of SceneJsonStream
+//
+
+#include "../include/serialization/SceneJsonStream.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace serialization {
+
+    namespace {
+
+        // obstacle_count is only a hint: the reader reserves at most this many
+        // disks up front, so a corrupt count cannot claim gigabytes
+        constexpr std::size_t MAX_RESERVED_OBSTACLES = std::size_t{1} << 20;
+
+        /**
+         * Fills the scene from SAX events, keeping only the open containers on
+         * a stack: the root object, then either a start/goal point or the
+         * obstacles array, a disk object and its center
+         */
+        class SceneHandler : public nlohmann::json_sax<nlohmann::json> {
+        public:
+            explicit SceneHandler(geometry::Scene& scene) : scene_(scene) {}
+
+            bool null() override { return value_done(); }
+            bool boolean(bool) override { return value_done(); }
+            bool number_integer(number_integer_t value) override {
+                return number(static_cast<double>(value),
+                              value >= 0 ? std::optional<std::uint64_t>(static_cast<std::uint64_t>(value)) : std::nullopt);
+            }
+            bool number_unsigned(number_unsigned_t value) override {
+                return number(static_cast<double>(value), static_cast<std::uint64_t>(value));
+            }
+            bool number_float(number_float_t value, const string_t&) override {
+                return number(value, std::nullopt);
+            }
+            bool string(string_t&) override { return value_done(); }
+            bool binary(binary_t&) override { return value_done(); }
+
+            bool start_object(std::size_t) override {
+                if (frames_.size() == 2 && in_obstacles()) {
+                    disk_ = {};
+                    disk_fields_ = 0;
+                }
+                frames_.push_back({false, {}, 0});
+                return true;
+            }
+            bool key(string_t& key) override {
+                frames_.back().key = key;
+                return true;
+            }
+            bool end_object() override {
+                if (frames_.size() == 3 && in_obstacles()) {
+                    if (disk_fields_ != ALL_FIELDS) {
+                        throw std::runtime_error("Scene JSON obstacle " + std::to_string(frames_[1].index) +
+                                                 " lacks a center coordinate or the radius");
+                    }
+                    scene_.obstacles.push_back(disk_);
+                }
+                frames_.pop_back();
+                return value_done();
+            }
+            bool start_array(std::size_t) override {
+                frames_.push_back({true, {}, 0});
+                return true;
+            }
+            bool end_array() override {
+                frames_.pop_back();
+                return value_done();
+            }
+
+            bool parse_error(std::size_t position, const std::string&,
+                             const nlohmann::detail::exception& error) override {
+                throw std::runtime_error("Invalid scene JSON at byte " + std::to_string(position) + ": " +
+                                         error.what());
+            }
+
+        private:
+            struct Frame {
+                bool array;
+                std::string key;   // last key seen, for objects
+                std::size_t index; // values seen so far, for arrays
+            };
+
+            static constexpr unsigned FIELD_X = 1;
+            static constexpr unsigned FIELD_Y = 2;
+            static constexpr unsigned FIELD_RADIUS = 4;
+            static constexpr unsigned ALL_FIELDS = FIELD_X | FIELD_Y | FIELD_RADIUS;
+
+            geometry::Scene& scene_;
+            std::vector<Frame> frames_;
+            geometry::Disk disk_;
+            unsigned disk_fields_ = 0;
+
+            [[nodiscard]] bool at_root_key(const char* key) const {
+                return !frames_[0].array && frames_[0].key == key;
+            }
+
+            [[nodiscard]] bool in_obstacles() const {
+                return at_root_key("obstacles") && frames_[1].array;
+            }
+
+            /**
+             * 0 for x, 1 for y, -1 otherwise, from an {"x", "y"} object or an [x, y] array
+             */
+            [[nodiscard]] static int coordinate(const Frame& frame) {
+                if (frame.array) {
+                    return frame.index < 2 ? static_cast<int>(frame.index) : -1;
+                }
+                return frame.key == "x" ? 0 : (frame.key == "y" ? 1 : -1);
+            }
+
+            void set_center(int axis, double value) {
+                if (axis == 0) {
+                    disk_.center.x = value;
+                    disk_fields_ |= FIELD_X;
+                } else if (axis == 1) {
+                    disk_.center.y = value;
+                    disk_fields_ |= FIELD_Y;
+                }
+            }
+
+            /**
+             * Ids and counts must be non-negative integers; floats with an
+             * integral value, such as 3.0, are accepted too
+             */
+            [[nodiscard]] static std::size_t to_index(double value, std::optional<std::uint64_t> integer,
+                                                      const char* what) {
+                if (integer && *integer <= std::numeric_limits<std::size_t>::max()) {
+                    return static_cast<std::size_t>(*integer);
+                }
+                // 2^digits is exact as a double, unlike SIZE_MAX
+                const double limit = std::ldexp(1.0, std::numeric_limits<std::size_t>::digits);
+                if (!integer && value >= 0.0 && value < limit && std::floor(value) == value) {
+                    return static_cast<std::size_t>(value);
+                }
+                throw std::runtime_error(std::string("Scene JSON ") + what + " must be a non-negative integer");
+            }
+
+            /**
+             * integer is the exact value of non-negative JSON integers
+             */
+            bool number(double value, std::optional<std::uint64_t> integer) {
+                const std::size_t depth = frames_.size();
+                if (depth == 1) {
+                    if (at_root_key("width")) {
+                        scene_.width = value;
+                    } else if (at_root_key("height")) {
+                        scene_.height = value;
+                    } else if (at_root_key("obstacle_count")) {
+                        scene_.obstacles.reserve(std::min(to_index(value, integer, "obstacle_count"),
+                                                          MAX_RESERVED_OBSTACLES));
+                    }
+                } else if (depth == 2 && (at_root_key("start") || at_root_key("goal"))) {
+                    geometry::Point& point = at_root_key("start") ? scene_.start : scene_.goal;
+                    int axis = coordinate(frames_[1]);
+                    if (axis == 0) {
+                        point.x = value;
+                    } else if (axis == 1) {
+                        point.y = value;
+                    }
+                } else if (depth == 3 && in_obstacles() && !frames_[2].array) {
+                    const std::string& key = frames_[2].key;
+                    if (key == "x" || key == "y") {
+                        set_center(key == "x" ? 0 : 1, value);
+                    } else if (key == "radius") {
+                        disk_.radius = value;
+                        disk_fields_ |= FIELD_RADIUS;
+                    } else if (key == "id") {
+                        disk_.id = to_index(value, integer, "obstacle id");
+                    }
+                } else if (depth == 4 && in_obstacles() && !frames_[2].array && frames_[2].key == "center") {
+                    set_center(coordinate(frames_[3]), value);
+                }
+                return value_done();
+            }
+
+            bool value_done() {
+                if (!frames_.empty() && frames_.back().array) {
+                    ++frames_.back().index;
+                }
+                return true;
+            }
+        };
+
+        void write_number(std::ostream& out, double value) {
+            // JSON has no infinities or NaN; nlohmann writes them as null too
+            if (!std::isfinite(value)) {
+                out << "null";
+                return;
+            }
+            char buffer[32];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            out.write(buffer, result.ptr - buffer);
+        }
+
+        void write_point(std::ostream& out, const geometry::Point& point) {
+            out << "{\"x\": ";
+            write_number(out, point.x);
+            out << ", \"y\": ";
+            write_number(out, point.y);
+            out << '}';
+        }
+
+    }
+
+    geometry::Scene SceneJsonStream::read(std::istream& in) {
+        geometry::Scene scene;
+        SceneHandler handler(scene);
+        nlohmann::json::sax_parse(in, &handler);
+        return scene;
+    }
+
+    geometry::Scene SceneJsonStream::load_from_file(const std::string& filename) {
+        std::ifstream in(filename, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Cannot open scene file: " + filename);
+        }
+        return read(in);
+    }
+
+    void SceneJsonStream::write(const geometry::Scene& scene, std::ostream& out) {
+        out << "{\n  \"width\": ";
+        write_number(out, scene.width);
+        out << ",\n  \"height\": ";
+        write_number(out, scene.height);
+        out << ",\n  \"start\": ";
+        write_point(out, scene.start);
+        out << ",\n  \"goal\": ";
+        write_point(out, scene.goal);
+        out << ",\n  \"obstacle_count\": " << scene.obstacles.size() << ",\n  \"obstacles\": [";
+        for (std::size_t i = 0; i < scene.obstacles.size(); ++i) {
+            const geometry::Disk& disk = scene.obstacles[i];
+            out << (i == 0 ? "\n    " : ",\n    ") << "{\"center\": ";
+            write_point(out, disk.center);
+            out << ", \"radius\": ";
+            write_number(out, disk.radius);
+            out << ", \"id\": " << disk.id << '}';
+        }
+        out << (scene.obstacles.empty() ? "]" : "\n  ]") << "\n}\n";
+    }
+
+    bool SceneJsonStream::save_to_file(const geometry::Scene& scene, const std::string& filename) {
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        write(scene, out);
+        out.flush();
+        return static_cast<bool>(out);
+    }
+
+} // namespace serialization
@@ -0,0 +1,72 @@
+//
+// D* Lite replanning under moving obstacles, checked against a fresh A*
+//
+
+#include "../include/algorithms/DStarLitePlanner.h"
+#include "../include/algorithms/AStarPlanner.h"
+#include "../include/algorithms/GridGraphBuilder.h"
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+
+namespace {
+
+    double path_length(const geometry::Path& path) {
+        double length = 0.0;
+        for (std::size_t i = 1; i < path.points.size(); ++i) {
+            length += path.points[i - 1].distance(path.points[i]);
+        }
+        return length;
+    }
+
+}
+
+int main() {
+    using namespace algorithms;
+    int failures = 0;
+    int replans = 0;
+
+    for (unsigned seed = 1; seed <= 4; ++seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> coordinate(0.0, 80.0);
+        std::uniform_real_distribution<double> radius(1.0, 5.0);
+
+        geometry::Scene scene({2.0, 2.0}, {78.0, 78.0}, 80.0, 80.0);
+        for (std::size_t i = 0; i < 40; ++i) {
+            scene.add_obstacle(geometry::Disk({coordinate(rng), coordinate(rng)}, radius(rng), i));
+        }
+
+        auto builder = std::make_shared<graph::GridGraphBuilder>(1.0, true);
+        DStarLitePlanner dstar(builder, make_node_locator(builder));
+        auto reference_builder = std::make_shared<graph::GridGraphBuilder>(1.0, true);
+        AStarPlanner<OctileHeuristic> astar(reference_builder, make_node_locator(reference_builder));
+
+        for (int call = 0; call < 200; ++call) {
+            for (int moved = 0; moved < 3; ++moved) {
+                geometry::Disk& disk = scene.obstacles[rng() % scene.obstacles.size()];
+                disk.center = {coordinate(rng), coordinate(rng)};
+            }
+            // The start walks around now and then, the goal stays put
+            if (call % 10 == 0) {
+                scene.start = {coordinate(rng), coordinate(rng)};
+            }
+
+            PathResult replanned = dstar.find_path(scene);
+            PathResult fresh = astar.find_path(scene);
+            ++replans;
+            if (replanned.has_value() != fresh.has_value()) {
+                std::fprintf(stderr, "seed %u call %d: D* Lite %s a path, A* %s\n", seed, call,
+                             replanned ? "found" : "did not find", fresh ? "did" : "did not");
+                ++failures;
+            } else if (replanned && std::abs(path_length(*replanned) - path_length(*fresh)) > 1e-6) {
+                std::fprintf(stderr, "seed %u call %d: D* Lite length %.9f, A* %.9f\n", seed, call,
+                             path_length(*replanned), path_length(*fresh));
+                ++failures;
+            }
+        }
+    }
+
+    std::printf("%d replans, %d mismatches\n", replans, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+//
+// Jump Point Search path lengths, checked against A* on the same grid graph
+//
+
+#include "../include/algorithms/JpsPlanner.h"
+#include "../include/algorithms/AStarPlanner.h"
+#include "../include/algorithms/GridGraphBuilder.h"
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+
+namespace {
+
+    double path_length(const geometry::Path& path) {
+        double length = 0.0;
+        for (std::size_t i = 1; i < path.points.size(); ++i) {
+            length += path.points[i - 1].distance(path.points[i]);
+        }
+        return length;
+    }
+
+}
+
+int main() {
+    using namespace algorithms;
+    int failures = 0;
+    int queries = 0;
+
+    for (unsigned seed = 1; seed <= 6; ++seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> coordinate(0.0, 100.0);
+        std::uniform_real_distribution<double> radius(0.3, seed % 2 == 0 ? 8.0 : 2.5);
+
+        geometry::Scene scene({0.0, 0.0}, {0.0, 0.0}, 100.0, 100.0);
+        for (std::size_t i = 0; i < 60 + 20 * seed; ++i) {
+            scene.add_obstacle(geometry::Disk({coordinate(rng), coordinate(rng)}, radius(rng), i));
+        }
+
+        // A fine and a coarse step: disks clip edges between free cells at both
+        for (double step : {1.0, 2.5}) {
+            auto builder = std::make_shared<graph::GridGraphBuilder>(step, true);
+            JpsPlanner jps(builder);
+            auto reference_builder = std::make_shared<graph::GridGraphBuilder>(step, true);
+            AStarPlanner<OctileHeuristic> astar(reference_builder, make_node_locator(reference_builder));
+
+            for (int query = 0; query < 40; ++query) {
+                scene.start = {coordinate(rng), coordinate(rng)};
+                scene.goal = {coordinate(rng), coordinate(rng)};
+                PathResult jumped = jps.find_path(scene);
+                PathResult reference = astar.find_path(scene);
+                ++queries;
+                if (jumped.has_value() != reference.has_value()) {
+                    std::fprintf(stderr, "seed %u step %.1f query %d: JPS %s a path, A* %s\n", seed, step, query,
+                                 jumped ? "found" : "did not find", reference ? "did" : "did not");
+                    ++failures;
+                } else if (jumped && std::abs(path_length(*jumped) - path_length(*reference)) > 1e-6) {
+                    std::fprintf(stderr, "seed %u step %.1f query %d: JPS length %.9f, A* %.9f\n", seed, step,
+                                 query, path_length(*jumped), path_length(*reference));
+                    ++failures;
+                }
+            }
+        }
+    }
+
+    std::printf("%d queries, %d mismatches\n", queries, failures);
+    return failures == 0 ? 0 : 1;
+}
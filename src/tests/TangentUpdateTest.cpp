@@ -0,0 +1,124 @@
+//
+// Tangent graph patched by update() after obstacle changes, checked against
+// building it from scratch
+//
+
+#include "../include/algorithms/TangentGraphBuilder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+    struct Edge {
+        geometry::Point from;
+        geometry::Point to;
+        double weight;
+    };
+
+    bool before(const Edge& a, const Edge& b) {
+        if (a.from.x != b.from.x) return a.from.x < b.from.x;
+        if (a.from.y != b.from.y) return a.from.y < b.from.y;
+        if (a.to.x != b.to.x) return a.to.x < b.to.x;
+        return a.to.y < b.to.y;
+    }
+
+    /**
+     * Edges by endpoint coordinates, so node numbering does not matter
+     */
+    std::vector<Edge> edges_of(const algorithms::graph::Graph& graph,
+                               const algorithms::graph::TangentGraphBuilder& builder) {
+        std::vector<Edge> edges;
+        for (std::size_t u = 0; u < graph.adj.size(); ++u) {
+            auto from = builder.get_node_point(static_cast<algorithms::graph::NodeId>(u));
+            for (const auto& edge : graph.adj[u]) {
+                auto to = builder.get_node_point(static_cast<algorithms::graph::NodeId>(edge.to));
+                edges.push_back({from, to, edge.weight});
+            }
+        }
+        std::sort(edges.begin(), edges.end(), before);
+        return edges;
+    }
+
+    int compare(const char* label, const algorithms::graph::Graph& patched,
+                const algorithms::graph::TangentGraphBuilder& patched_builder, const geometry::Scene& scene) {
+        algorithms::graph::TangentGraphBuilder builder;
+        algorithms::graph::Graph rebuilt = builder.build(scene);
+        std::vector<Edge> expected = edges_of(rebuilt, builder);
+        std::vector<Edge> actual = edges_of(patched, patched_builder);
+        if (actual.size() != expected.size()) {
+            std::fprintf(stderr, "%s: %zu edges, rebuilt %zu\n", label, actual.size(), expected.size());
+            return 1;
+        }
+        for (std::size_t e = 0; e < expected.size(); ++e) {
+            if (actual[e].from.distance(expected[e].from) > 1e-9 || actual[e].to.distance(expected[e].to) > 1e-9 ||
+                std::abs(actual[e].weight - expected[e].weight) > 1e-9) {
+                std::fprintf(stderr, "%s: edge %zu differs from the rebuilt graph\n", label, e);
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+}
+
+int main() {
+    int failures = 0;
+    int updates = 0;
+    char label[64];
+
+    for (unsigned seed = 1; seed <= 12; ++seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> coordinate(0.0, 100.0);
+        std::uniform_real_distribution<double> radius(0.5, seed % 2 == 0 ? 10.0 : 4.0);
+        std::uniform_real_distribution<double> shift(-8.0, 8.0);
+
+        geometry::Scene scene({coordinate(rng), coordinate(rng)}, {coordinate(rng), coordinate(rng)});
+        std::size_t next_id = 0;
+        for (std::size_t i = 0; i < 30 + 3 * seed; ++i) {
+            scene.add_obstacle(geometry::Disk({coordinate(rng), coordinate(rng)}, radius(rng), next_id++));
+        }
+
+        algorithms::graph::TangentGraphBuilder builder;
+        algorithms::graph::Graph graph = builder.build(scene);
+
+        for (int step = 0; step < 15; ++step) {
+            std::vector<geometry::Disk> before = scene.obstacles;
+            auto& disks = scene.obstacles;
+            int changes = 1 + static_cast<int>(rng() % 3);
+            for (int c = 0; c < changes; ++c) {
+                std::size_t k = rng() % disks.size();
+                switch (rng() % 6) {
+                    case 0:
+                        disks.emplace_back(geometry::Point{coordinate(rng), coordinate(rng)}, radius(rng), next_id++);
+                        break;
+                    case 1:
+                        disks.erase(disks.begin() + static_cast<std::ptrdiff_t>(k));
+                        break;
+                    case 2:
+                        // Over a terminal, cutting it off, or off it again
+                        disks[k].center = step % 2 == 0 ? scene.start : scene.goal;
+                        break;
+                    default:
+                        disks[k].center = {disks[k].center.x + shift(rng), disks[k].center.y + shift(rng)};
+                        break;
+                }
+            }
+
+            std::vector<geometry::ObstacleDelta> deltas = geometry::diff_obstacles(before, scene.obstacles);
+            std::vector<std::size_t> affected = builder.update(scene, deltas, graph);
+            std::snprintf(label, sizeof(label), "seed %u step %d", seed, step);
+            if (std::any_of(affected.begin(), affected.end(), [&](std::size_t n) { return n >= graph.adj.size(); })) {
+                std::fprintf(stderr, "%s: affected node out of range\n", label);
+                ++failures;
+            }
+            failures += compare(label, graph, builder, scene);
+            ++updates;
+        }
+    }
+
+    std::printf("%d updates, %d mismatches\n", updates, failures);
+    return failures == 0 ? 0 : 1;
+}
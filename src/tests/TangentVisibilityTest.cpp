@@ -0,0 +1,157 @@
+//
+// Tangent graph built with the visibility sweeps, checked against testing
+// every tangent segment against every disk
+//
+
+#include "../include/algorithms/TangentGraphBuilder.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+    struct Segment {
+        geometry::Point first;
+        geometry::Point second;
+    };
+
+    // Same construction as the builder's, so both sides see identical points
+    int circle_tangents(const geometry::Point& c1, double r1, const geometry::Point& c2, double r2,
+                        bool inner, Segment* out) {
+        double dx = c2.x - c1.x;
+        double dy = c2.y - c1.y;
+        double d = std::hypot(dx, dy);
+        double signed_r2 = inner ? -r2 : r2;
+        if (d <= 0.0) {
+            return 0;
+        }
+        double cos_a = (r1 - signed_r2) / d;
+        if (std::abs(cos_a) >= 1.0) {
+            return 0;
+        }
+        double sin_a = std::sqrt(1.0 - cos_a * cos_a);
+        double ux = dx / d;
+        double uy = dy / d;
+        int count = 0;
+        for (double side : {1.0, -1.0}) {
+            double nx = ux * cos_a - side * uy * sin_a;
+            double ny = uy * cos_a + side * ux * sin_a;
+            out[count++] = {{c1.x + r1 * nx, c1.y + r1 * ny},
+                            {c2.x + signed_r2 * nx, c2.y + signed_r2 * ny}};
+        }
+        return count;
+    }
+
+    bool is_clear(const std::vector<geometry::Disk>& disks, const geometry::Point& a, const geometry::Point& b,
+                  std::size_t skip_first, std::size_t skip_second) {
+        for (std::size_t k = 0; k < disks.size(); ++k) {
+            const geometry::Disk& disk = disks[k];
+            if (k != skip_first && k != skip_second &&
+                disk.distance_to_segment(a, b) < disk.radius - 1e-9 * (1.0 + disk.radius)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Nodes of the tangent graph in the order the builder adds them
+     */
+    std::vector<geometry::Point> brute_force_nodes(const geometry::Scene& scene) {
+        const auto& disks = scene.obstacles;
+        const std::size_t none = disks.size();
+        std::vector<geometry::Point> nodes {scene.start, scene.goal};
+        Segment tangents[2];
+
+        for (const geometry::Point& from : {scene.start, scene.goal}) {
+            bool inside = false;
+            for (const auto& disk : disks) {
+                inside = inside || disk.center.distance(from) <= disk.radius;
+            }
+            if (inside) {
+                continue;
+            }
+            for (std::size_t i = 0; i < disks.size(); ++i) {
+                int count = circle_tangents(from, 0.0, disks[i].center, disks[i].radius, false, tangents);
+                for (int t = 0; t < count; ++t) {
+                    if (is_clear(disks, from, tangents[t].second, i, none)) {
+                        nodes.push_back(tangents[t].second);
+                    }
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < disks.size(); ++i) {
+            for (std::size_t j = i + 1; j < disks.size(); ++j) {
+                for (bool inner : {false, true}) {
+                    int count = circle_tangents(disks[i].center, disks[i].radius,
+                                                disks[j].center, disks[j].radius, inner, tangents);
+                    for (int t = 0; t < count; ++t) {
+                        if (is_clear(disks, tangents[t].first, tangents[t].second, i, j)) {
+                            nodes.push_back(tangents[t].first);
+                            nodes.push_back(tangents[t].second);
+                        }
+                    }
+                }
+            }
+        }
+        return nodes;
+    }
+
+    int compare(const char* label, const geometry::Scene& scene) {
+        algorithms::graph::TangentGraphBuilder builder;
+        algorithms::graph::Graph graph = builder.build(scene);
+        std::vector<geometry::Point> expected = brute_force_nodes(scene);
+        if (graph.adj.size() != expected.size()) {
+            std::fprintf(stderr, "%s: %zu nodes, brute force %zu\n", label, graph.adj.size(), expected.size());
+            return 1;
+        }
+        for (std::size_t n = 0; n < expected.size(); ++n) {
+            if (builder.get_node_point(static_cast<algorithms::graph::NodeId>(n)).distance(expected[n]) > 1e-9) {
+                std::fprintf(stderr, "%s: node %zu differs from brute force\n", label, n);
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+}
+
+int main() {
+    int failures = 0;
+    int scenes = 0;
+    char label[64];
+
+    // Scattered disks of mixed sizes, many of them overlapping
+    for (unsigned seed = 1; seed <= 20; ++seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> coordinate(0.0, 100.0);
+        std::uniform_real_distribution<double> radius(0.5, seed % 2 == 0 ? 12.0 : 4.0);
+
+        geometry::Scene scene({coordinate(rng), coordinate(rng)}, {coordinate(rng), coordinate(rng)});
+        for (std::size_t i = 0; i < 30 + 5 * seed; ++i) {
+            scene.add_obstacle(geometry::Disk({coordinate(rng), coordinate(rng)}, radius(rng), i));
+        }
+        std::snprintf(label, sizeof(label), "random seed %u", seed);
+        failures += compare(label, scene);
+        ++scenes;
+    }
+
+    // Equal disks on a lattice: bitangents along a row graze every disk between
+    for (double spacing : {6.0, 4.0}) {
+        geometry::Scene scene({0.5, 0.5}, {49.5, 49.5}, 50.0, 50.0);
+        std::size_t id = 0;
+        for (double y = 5.0; y < 50.0; y += spacing) {
+            for (double x = 5.0; x < 50.0; x += spacing) {
+                scene.add_obstacle(geometry::Disk({x, y}, 1.0 + (spacing == 4.0 ? 1.5 : 0.0), id++));
+            }
+        }
+        std::snprintf(label, sizeof(label), "lattice spacing %.0f", spacing);
+        failures += compare(label, scene);
+        ++scenes;
+    }
+
+    std::printf("%d scenes, %d mismatches\n", scenes, failures);
+    return failures == 0 ? 0 : 1;
+}